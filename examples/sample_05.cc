@@ -7,16 +7,23 @@
 #include "vita/anim/clip.h"
 #include "vita/anim/skeleton.h"
 #include "vita/anim/mesh.h"
+#include "vita/anim/compactmesh.h"
 #include "vita/anim/texture.h"
 #include "vita/anim/shader.h"
 #include "vita/anim/gltfloader.h"
 #include "vita/anim/uniform.h"
+#include "vita/anim/uniformbuffer.h"
 #include "vita/assets.h"
 
 struct AnimationInstance
 {
 	Pose mAnimatedPose;
 	std::vector<mat4> mPosePalette;
+	std::vector<mat4> mSkinPalette;
+	std::vector<affine3x4> mPoseAffines;
+	std::vector<affine3x4> mSkinAffines;
+	std::vector<DualQuaternion> mPoseDualQuaternions;
+	std::vector<DualQuaternion> mSkinDualQuaternions;
 	std::size_t mClip;
 	float mPlayback;
 	Transform mModel;
@@ -33,14 +40,25 @@ struct Sample : public App
 	Texture* mDiffuseTexture;
 	Shader* mStaticShader;
 	Shader* mSkinnedShader;
+	Shader* mDualQuaternionShader;
+	Shader* mAffineShader;
+	Shader* mCompactShader;
+	PaletteBuffer* mPaletteBuffer;
 	std::vector<Mesh> mCPUMeshes;
 	std::vector<Mesh> mGPUMeshes;
+	std::vector<CompactMesh> mCompactMeshes;
 	Skeleton mSkeleton;
 	std::vector<Clip> mClips;
 
 	AnimationInstance mGPUAnimInfo;
 	AnimationInstance mCPUAnimInfo;
 
+	jobs::JobSystem mJobSystem{jobs::get_default_number_of_workers()};
+
+	bool use_dual_quaternions = false;
+	bool use_affine_palette = false;
+	bool use_compact_vertices = false;
+
 	Sample();
 	~Sample();
 
@@ -49,6 +67,9 @@ struct Sample : public App
 
 	void on_gui() override
 	{
+		ImGui::Checkbox("Dual quaternion skinning", &use_dual_quaternions);
+		ImGui::Checkbox("Affine 3x4 palette", &use_affine_palette);
+		ImGui::Checkbox("Compact vertices", &use_compact_vertices);
 	}
 };
 
@@ -60,14 +81,39 @@ Sample::Sample()
 	mClips = get_animation_clips(gltf);
 	free_gltf_file(gltf);
 
+	// so calc_matrix_palette doesn't need to walk to the root for every joint
+	const auto order = sort_joints_parent_before_child(mSkeleton);
+	for (auto& mesh: mCPUMeshes)
+	{
+		remap_joints(mesh, order);
+		mesh.UpdateOpenGLBuffers();
+	}
+	for (auto& clip: mClips)
+	{
+		remap_joints(clip, order);
+	}
+
 	mGPUMeshes = mCPUMeshes;
 	for (std::size_t i = 0, size = mGPUMeshes.size(); i < size; ++i)
 	{
 		mGPUMeshes[i].UpdateOpenGLBuffers();
 	}
+	for (const auto& mesh: mGPUMeshes)
+	{
+		mCompactMeshes.emplace_back().set(mesh);
+	}
 
 	mStaticShader = new Shader(assets::static_shader(), assets::lit_shader());
-	mSkinnedShader = new Shader(assets::skinned_shader(), assets::lit_shader());
+	mSkinnedShader = new Shader(assets::skinned_palette_buffer_shader(), assets::lit_shader());
+	mSkinnedShader->bind_uniform_block("SkinPalette", SKIN_PALETTE_BINDING);
+	mPaletteBuffer = new PaletteBuffer();
+	mPaletteBuffer->resize(1);
+	mDualQuaternionShader
+		= new Shader(assets::skinned_dual_quaternion_shader(), assets::lit_shader());
+	mAffineShader = new Shader(assets::skinned_affine_shader(), assets::lit_shader());
+	mAffineShader->bind_uniform_block("SkinPalette", SKIN_PALETTE_BINDING);
+	mCompactShader = new Shader(assets::skinned_compact_shader(), assets::lit_shader());
+	mCompactShader->bind_uniform_block("SkinPalette", SKIN_PALETTE_BINDING);
 	mDiffuseTexture = new Texture(assets::woman_texture());
 
 	mGPUAnimInfo.mAnimatedPose = mSkeleton.rest_pose;
@@ -103,10 +149,45 @@ void Sample::on_frame(float deltaTime)
 
 	for (std::size_t i = 0, size = mCPUMeshes.size(); i < size; ++i)
 	{
-		mCPUMeshes[i].CPUSkin(mSkeleton, mCPUAnimInfo.mAnimatedPose);
+		if (use_dual_quaternions)
+		{
+			mCPUMeshes[i].CPUSkinDualQuaternion(mSkeleton, mCPUAnimInfo.mAnimatedPose);
+		}
+		else
+		{
+			mCPUMeshes[i].CPUSkin(mJobSystem, mSkeleton, mCPUAnimInfo.mAnimatedPose);
+		}
 	}
 
-	mGPUAnimInfo.mPosePalette = calc_matrix_palette(mGPUAnimInfo.mAnimatedPose);
+	if (use_dual_quaternions)
+	{
+		calc_dual_quaternion_palette(
+			mGPUAnimInfo.mAnimatedPose, mGPUAnimInfo.mPoseDualQuaternions
+		);
+		calc_skin_palette(
+			mGPUAnimInfo.mPoseDualQuaternions,
+			mSkeleton.inverse_bind_dual_quaternions,
+			mGPUAnimInfo.mSkinDualQuaternions
+		);
+	}
+	else if (use_affine_palette)
+	{
+		calc_affine_palette(mGPUAnimInfo.mAnimatedPose, mGPUAnimInfo.mPoseAffines);
+		calc_skin_palette(
+			mGPUAnimInfo.mPoseAffines, mSkeleton.inverse_bind_affines, mGPUAnimInfo.mSkinAffines
+		);
+		mPaletteBuffer->set_palette(0, mGPUAnimInfo.mSkinAffines);
+		mPaletteBuffer->upload();
+	}
+	else
+	{
+		calc_matrix_palette(mGPUAnimInfo.mAnimatedPose, mGPUAnimInfo.mPosePalette);
+		calc_skin_palette(
+			mGPUAnimInfo.mPosePalette, mSkeleton.inverse_bind_pose, mGPUAnimInfo.mSkinPalette
+		);
+		mPaletteBuffer->set_palette(0, mGPUAnimInfo.mSkinPalette);
+		mPaletteBuffer->upload();
+	}
 }
 
 void Sample::on_render(float inAspectRatio)
@@ -147,36 +228,68 @@ void Sample::on_render(float inAspectRatio)
 
 	// GPU Skinned Mesh
 	model = mat4_from_transform(mGPUAnimInfo.mModel);
-	mSkinnedShader->bind();
-	Uniform<mat4>::Set(mSkinnedShader->get_uniform("model"), model);
-	Uniform<mat4>::Set(mSkinnedShader->get_uniform("view"), view);
-	Uniform<mat4>::Set(mSkinnedShader->get_uniform("projection"), projection);
-	Uniform<vec3>::Set(mSkinnedShader->get_uniform("light"), vec3(1, 1, 1));
-
-	Uniform<mat4>::Set(mSkinnedShader->get_uniform("pose"), mGPUAnimInfo.mPosePalette);
-	Uniform<mat4>::Set(mSkinnedShader->get_uniform("invBindPose"), mSkeleton.inverse_bind_pose);
+	// the compact shader only reads a matrix palette
+	const auto is_compact
+		= use_compact_vertices && use_dual_quaternions == false && use_affine_palette == false;
+	auto* skinned_shader = is_compact ? mCompactShader : mSkinnedShader;
+	if (use_dual_quaternions)
+	{
+		skinned_shader = mDualQuaternionShader;
+	}
+	else if (use_affine_palette)
+	{
+		skinned_shader = mAffineShader;
+	}
+	skinned_shader->bind();
+	Uniform<mat4>::Set(skinned_shader->get_uniform("model"), model);
+	Uniform<mat4>::Set(skinned_shader->get_uniform("view"), view);
+	Uniform<mat4>::Set(skinned_shader->get_uniform("projection"), projection);
+	Uniform<vec3>::Set(skinned_shader->get_uniform("light"), vec3(1, 1, 1));
 
-	mDiffuseTexture->bind(mSkinnedShader->get_uniform("tex0"), 0);
-	for (std::size_t i = 0, size = mGPUMeshes.size(); i < size; ++i)
+	if (use_dual_quaternions)
 	{
-		mGPUMeshes[i].Bind(
-			static_cast<int>(mSkinnedShader->get_attribute("position")),
-			static_cast<int>(mSkinnedShader->get_attribute("normal")),
-			static_cast<int>(mSkinnedShader->get_attribute("texCoord")),
-			static_cast<int>(mSkinnedShader->get_attribute("weights")),
-			static_cast<int>(mSkinnedShader->get_attribute("joints"))
-		);
-		mGPUMeshes[i].Draw();
-		mGPUMeshes[i].UnBind(
-			static_cast<int>(mSkinnedShader->get_attribute("position")),
-			static_cast<int>(mSkinnedShader->get_attribute("normal")),
-			static_cast<int>(mSkinnedShader->get_attribute("texCoord")),
-			static_cast<int>(mSkinnedShader->get_attribute("weights")),
-			static_cast<int>(mSkinnedShader->get_attribute("joints"))
+		Uniform<DualQuaternion>::Set(
+			skinned_shader->get_uniform("skin"), mGPUAnimInfo.mSkinDualQuaternions
 		);
 	}
+	else
+	{
+		mPaletteBuffer->bind_palette(0);
+	}
+
+	mDiffuseTexture->bind(skinned_shader->get_uniform("tex0"), 0);
+	if (is_compact)
+	{
+		for (auto& mesh: mCompactMeshes)
+		{
+			mesh.bind();
+			mesh.draw();
+			mesh.unbind();
+		}
+	}
+	else
+	{
+		for (std::size_t i = 0, size = mGPUMeshes.size(); i < size; ++i)
+		{
+			mGPUMeshes[i].Bind(
+				static_cast<int>(skinned_shader->get_attribute("position")),
+				static_cast<int>(skinned_shader->get_attribute("normal")),
+				static_cast<int>(skinned_shader->get_attribute("texCoord")),
+				static_cast<int>(skinned_shader->get_attribute("weights")),
+				static_cast<int>(skinned_shader->get_attribute("joints"))
+			);
+			mGPUMeshes[i].Draw();
+			mGPUMeshes[i].UnBind(
+				static_cast<int>(skinned_shader->get_attribute("position")),
+				static_cast<int>(skinned_shader->get_attribute("normal")),
+				static_cast<int>(skinned_shader->get_attribute("texCoord")),
+				static_cast<int>(skinned_shader->get_attribute("weights")),
+				static_cast<int>(skinned_shader->get_attribute("joints"))
+			);
+		}
+	}
 	mDiffuseTexture->unbind(0);
-	mSkinnedShader->unbind();
+	skinned_shader->unbind();
 }
 
 Sample::~Sample()
@@ -184,9 +297,14 @@ Sample::~Sample()
 	delete mStaticShader;
 	delete mDiffuseTexture;
 	delete mSkinnedShader;
+	delete mDualQuaternionShader;
+	delete mAffineShader;
+	delete mCompactShader;
+	delete mPaletteBuffer;
 	mClips.clear();
 	mCPUMeshes.clear();
 	mGPUMeshes.clear();
+	mCompactMeshes.clear();
 }
 
 IMPLEMENT_MAIN(Sample)
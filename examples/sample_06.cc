@@ -11,6 +11,8 @@
 struct Sample : public App
 {
 	std::vector<Transform> local_transforms;
+	std::vector<vec3> points;
+	IkScratch scratch;
 
 	Transform mTarget;
 	DebugDraw* mSolverLines;
@@ -102,7 +104,7 @@ void Sample::on_frame(float deltaTime)
 	mTarget = mTargetPath.get_sample(mTarget, mPlayTime, true);
 
 	IkFunction solver = use_ccd ? ik_ccd : ik_fabrik;
-	solver(local_transforms, mTarget, DEFAULT_NUM_STEPS, DEFAULT_THRESHOLD);
+	solver(local_transforms, mTarget, DEFAULT_NUM_STEPS, DEFAULT_THRESHOLD, scratch);
 }
 
 void Sample::on_render(float inAspectRatio)
@@ -117,7 +119,7 @@ void Sample::on_render(float inAspectRatio)
 	mat4 view = mat4_from_look_at(cameraPos, vec3(0, 0, 0), vec3(0, 1, 0));
 	mat4 mvp = projection * view;  // No model
 
-	const auto points = GetGlobalTransforms(local_transforms);
+	GetGlobalTransforms(local_transforms, points);
 	mSolverLines->LinesFromIKSolver(points);
 	mSolverPoints->PointsFromIKSolver(points);
 
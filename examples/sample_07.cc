@@ -14,6 +14,7 @@
 #include "vita/anim/ikleg.h"
 #include "vita/anim/gltfloader.h"
 #include "vita/anim/uniform.h"
+#include "vita/anim/uniformbuffer.h"
 
 #include "vita/dependency_glad.h"
 
@@ -36,6 +37,7 @@ struct Sample : public App
 	std::vector<Mesh> mMeshes;
 	Pose mCurrentPose;
 	std::vector<mat4> mPosePalette;
+	std::vector<mat4> mSkinPalette;
 	float mSinkIntoGround;
 
 	IKLeg* mLeftLeg;
@@ -46,6 +48,7 @@ struct Sample : public App
 	Texture* mDiffuseTexture;
 	Shader* mStaticShader;
 	Shader* mSkinnedShader;
+	PaletteBuffer* mPaletteBuffer;
 	Skeleton mSkeleton;
 	std::vector<Clip> mClips;
 	std::size_t mCurrentClip;
@@ -266,6 +269,18 @@ Sample::Sample()
 	mClips = get_animation_clips(gltf);
 	free_gltf_file(gltf);
 
+	// so calc_matrix_palette doesn't need to walk to the root for every joint
+	const auto order = sort_joints_parent_before_child(mSkeleton);
+	for (auto& mesh: mMeshes)
+	{
+		remap_joints(mesh, order);
+		mesh.UpdateOpenGLBuffers();
+	}
+	for (auto& clip: mClips)
+	{
+		remap_joints(clip, order);
+	}
+
 	gltf = load_gltf_file(assets::ik_course_gltf());
 	mIKCourse = LoadStaticMeshes(gltf);
 	free_gltf_file(gltf);
@@ -273,7 +288,10 @@ Sample::Sample()
 	mTriangles = MeshesToTriangles(mIKCourse);
 
 	mStaticShader = new Shader(assets::static_shader(), assets::lit_shader());
-	mSkinnedShader = new Shader(assets::skinned_shader(), assets::lit_shader());
+	mSkinnedShader = new Shader(assets::skinned_palette_buffer_shader(), assets::lit_shader());
+	mSkinnedShader->bind_uniform_block("SkinPalette", SKIN_PALETTE_BINDING);
+	mPaletteBuffer = new PaletteBuffer();
+	mPaletteBuffer->resize(1);
 	mDiffuseTexture = new Texture(assets::woman_texture());
 
 	mLeftLeg = new IKLeg(mSkeleton, "LeftUpLeg", "LeftLeg", "LeftFoot", "LeftToeBase");
@@ -538,7 +556,10 @@ void Sample::on_frame(float deltaTime)
 	}
 
 	// Update the matrix palette for skinning
-	mPosePalette = calc_matrix_palette(mCurrentPose);
+	calc_matrix_palette(mCurrentPose, mPosePalette);
+	calc_skin_palette(mPosePalette, mSkeleton.inverse_bind_pose, mSkinPalette);
+	mPaletteBuffer->set_palette(0, mSkinPalette);
+	mPaletteBuffer->upload();
 }
 
 void Sample::on_render(float inAspectRatio)
@@ -562,10 +583,7 @@ void Sample::on_render(float inAspectRatio)
 		Uniform<mat4>::Set(characterShader->get_uniform("view"), view);
 		Uniform<mat4>::Set(characterShader->get_uniform("projection"), projection);
 		Uniform<vec3>::Set(characterShader->get_uniform("light"), vec3(1, 1, 1));
-		Uniform<mat4>::Set(characterShader->get_uniform("pose"), mPosePalette);
-		Uniform<mat4>::Set(
-			characterShader->get_uniform("invBindPose"), mSkeleton.inverse_bind_pose
-		);
+		mPaletteBuffer->bind_palette(0);
 
 		mDiffuseTexture->bind(characterShader->get_uniform("tex0"), 0);
 		for (std::size_t i = 0, size = mMeshes.size(); i < size; ++i)
@@ -650,6 +668,7 @@ Sample::~Sample()
 	delete mStaticShader;
 	delete mDiffuseTexture;
 	delete mSkinnedShader;
+	delete mPaletteBuffer;
 	delete mCourseTexture;
 	delete mLeftLeg;
 	delete mRightLeg;
@@ -0,0 +1,136 @@
+#include "vita/vita.h"
+
+#include <vector>
+
+#include "vita/anim/clip.h"
+#include "vita/anim/crowd.h"
+#include "vita/anim/crowdrenderer.h"
+#include "vita/anim/gltfloader.h"
+#include "vita/anim/mesh.h"
+#include "vita/anim/skeleton.h"
+#include "vita/anim/texture.h"
+#include "vita/assets.h"
+
+/// a crowd of animated characters drawn with one instanced draw call per mesh
+struct Sample : public App
+{
+	std::vector<Mesh> mMeshes;
+	Skeleton mSkeleton;
+	std::vector<Clip> mClips;
+	Texture* mDiffuseTexture;
+	CrowdRenderer* mRenderer;
+	BakedCrowdRenderer* mBakedRenderer;
+
+	jobs::JobSystem mJobSystem{jobs::get_default_number_of_workers()};
+	std::vector<CrowdCharacter> mCharacters;
+	int mCrowdSize = 15;
+	bool mUseBakedAnimations = false;
+
+	Sample();
+	~Sample();
+
+	void SetCrowdSize();
+
+	void on_frame(float deltaTime) override;
+	void on_render(float inAspectRatio) override;
+
+	void on_gui() override
+	{
+		// 19 * 19 palettes of woman.gltf stay below the smallest GL_MAX_TEXTURE_BUFFER_SIZE
+		if (ImGui::SliderInt("Crowd size", &mCrowdSize, 1, 19))
+		{
+			SetCrowdSize();
+		}
+		ImGui::Text("%d characters", mCrowdSize * mCrowdSize);
+		ImGui::Text("%d draw calls", static_cast<int>(mMeshes.size()));
+		ImGui::Checkbox("Baked animations", &mUseBakedAnimations);
+	}
+};
+
+Sample::Sample()
+{
+	cgltf_data* gltf = load_gltf_file(assets::woman_gltf());
+	mMeshes = LoadMeshes(gltf);
+	mSkeleton = LoadSkeleton(gltf);
+	mClips = get_animation_clips(gltf);
+	free_gltf_file(gltf);
+
+	const auto order = sort_joints_parent_before_child(mSkeleton);
+	for (auto& mesh: mMeshes)
+	{
+		remap_joints(mesh, order);
+		mesh.UpdateOpenGLBuffers();
+	}
+	for (auto& clip: mClips)
+	{
+		remap_joints(clip, order);
+	}
+
+	mDiffuseTexture = new Texture(assets::woman_texture());
+	mRenderer = new CrowdRenderer(assets::skinned_crowd_shader(), assets::lit_shader());
+	// 24 samples a second keeps all clips of woman.gltf below the smallest GL_MAX_TEXTURE_SIZE
+	const auto baked = bake_animation(mClips, mSkeleton, 24.0f);
+	mBakedRenderer
+		= new BakedCrowdRenderer(assets::skinned_baked_shader(), assets::lit_shader(), baked);
+
+	SetCrowdSize();
+}
+
+void Sample::SetCrowdSize()
+{
+	const auto size = static_cast<std::size_t>(mCrowdSize);
+	mCharacters.resize(size * size);
+	for (std::size_t index = 0; index < mCharacters.size(); ++index)
+	{
+		auto& character = mCharacters[index];
+		const auto x = static_cast<float>(index % size) - static_cast<float>(size) * 0.5f;
+		const auto z = static_cast<float>(index / size);
+		character.clip = index % mClips.size();
+		character.time = static_cast<float>(index) * 0.37f;
+		character.model.position = vec3(x * 1.5f, 0.0f, -z * 1.5f);
+		if (character.pose.empty())
+		{
+			character.pose = mSkeleton.rest_pose;
+		}
+	}
+}
+
+void Sample::on_frame(float deltaTime)
+{
+	if (mUseBakedAnimations)
+	{
+		advance_crowd_time(mCharacters, mClips, deltaTime);
+		mBakedRenderer->set_instances(mCharacters);
+	}
+	else
+	{
+		update_crowd_palettes(mJobSystem, mCharacters, mClips, mSkeleton, deltaTime);
+		mRenderer->set_instances(mCharacters);
+	}
+}
+
+void Sample::on_render(float inAspectRatio)
+{
+	const mat4 projection = mat4_from_perspective(60.0f, inAspectRatio, 0.01f, 1000.0f);
+	const mat4 view = mat4_from_look_at(vec3(0, 8, 10), vec3(0, 0, -10), vec3(0, 1, 0));
+
+	if (mUseBakedAnimations)
+	{
+		mBakedRenderer->draw(mMeshes, *mDiffuseTexture, view, projection);
+	}
+	else
+	{
+		mRenderer->draw(mMeshes, *mDiffuseTexture, view, projection);
+	}
+}
+
+Sample::~Sample()
+{
+	delete mRenderer;
+	delete mBakedRenderer;
+	delete mDiffuseTexture;
+	mClips.clear();
+	mMeshes.clear();
+}
+
+IMPLEMENT_MAIN(Sample)
@@ -0,0 +1,99 @@
+#include "vita/allocations.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(_MSC_VER)
+	#include <malloc.h>
+#endif
+
+#ifndef NDEBUG
+namespace
+{
+std::atomic<std::size_t> number_of_allocations = 0;
+}  //  namespace
+
+// the array, nothrow and sized versions all end up here, or in the aligned version below, or in the
+// matching delete
+void* operator new(std::size_t size)
+{
+	number_of_allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* memory = std::malloc(size == 0 ? 1 : size))
+	{
+		return memory;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+// cpu::CacheAlignedVector allocates through this one
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	number_of_allocations.fetch_add(1, std::memory_order_relaxed);
+	const auto align = static_cast<std::size_t>(alignment);
+	#if defined(_MSC_VER)
+	void* memory = _aligned_malloc(size == 0 ? 1 : size, align);
+	#else
+	// aligned_alloc wants the size to be a multiple of the alignment
+	const auto rounded = size == 0 ? align : (size + align - 1) / align * align;
+	void* memory = std::aligned_alloc(align, rounded);
+	#endif
+	if (memory != nullptr)
+	{
+		return memory;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+	#if defined(_MSC_VER)
+	_aligned_free(memory);
+	#else
+	std::free(memory);
+	#endif
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t alignment) noexcept
+{
+	operator delete(memory, alignment);
+}
+#endif
+
+namespace allocations
+{
+bool is_counting()
+{
+#ifndef NDEBUG
+	return true;
+#else
+	return false;
+#endif
+}
+
+std::size_t get_total()
+{
+#ifndef NDEBUG
+	return number_of_allocations.load(std::memory_order_relaxed);
+#else
+	return 0;
+#endif
+}
+
+void FrameCounter::on_frame()
+{
+	const auto total = get_total();
+	allocations_last_frame = total - last_total;
+	last_total = total;
+}
+}  //  namespace allocations
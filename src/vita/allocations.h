@@ -0,0 +1,20 @@
+#pragma once
+
+/// counts the heap allocations made through operator new, only in debug builds since it replaces
+/// the global operator new
+namespace allocations
+{
+bool is_counting();
+
+/// the number of allocations since the program started
+std::size_t get_total();
+
+/// remembers the total between two frames
+struct FrameCounter
+{
+	std::size_t last_total = 0;
+	std::size_t allocations_last_frame = 0;
+
+	void on_frame();
+};
+}  //  namespace allocations
@@ -0,0 +1,65 @@
+#include "vita/anim/affine3x4.h"
+
+#include <cmath>
+#include <iostream>
+
+bool operator==(const affine3x4& a, const affine3x4& b)
+{
+	const auto* pa = a.data_ptr();
+	const auto* pb = b.data_ptr();
+	for (int i = 0; i < 12; ++i)
+	{
+		if (fabsf(pa[i] - pb[i]) > MAT4_EPSILON)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool operator!=(const affine3x4& a, const affine3x4& b)
+{
+	return ! (a == b);
+}
+
+affine3x4 get_inverse(const affine3x4& m)
+{
+	// cofactors of the 3x3 part, the first column of the inverse
+	const auto cxx = m.yy * m.zz - m.zy * m.yz;
+	const auto cxy = m.zy * m.xz - m.xy * m.zz;
+	const auto cxz = m.xy * m.yz - m.yy * m.xz;
+	const auto det = m.xx * cxx + m.yx * cxy + m.zx * cxz;
+
+	if (det == 0.0f)
+	{
+		std::cout << "WARNING: Trying to invert a matrix with a zero determinant\n";
+		return affine3x4();
+	}
+	const auto s = 1.0f / det;
+
+	const auto xx = cxx * s;
+	const auto yx = (m.zx * m.yz - m.yx * m.zz) * s;
+	const auto zx = (m.yx * m.zy - m.zx * m.yy) * s;
+	const auto xy = cxy * s;
+	const auto yy = (m.xx * m.zz - m.zx * m.xz) * s;
+	const auto zy = (m.zx * m.xy - m.xx * m.zy) * s;
+	const auto xz = cxz * s;
+	const auto yz = (m.yx * m.xz - m.xx * m.yz) * s;
+	const auto zz = (m.xx * m.yy - m.yx * m.xy) * s;
+
+	// the translation moves back through the inverted 3x3
+	return affine3x4(
+		xx,
+		yx,
+		zx,
+		-(xx * m.tx + yx * m.ty + zx * m.tz),
+		xy,
+		yy,
+		zy,
+		-(xy * m.tx + yy * m.ty + zy * m.tz),
+		xz,
+		yz,
+		zz,
+		-(xz * m.tx + yz * m.ty + zz * m.tz)
+	);
+}
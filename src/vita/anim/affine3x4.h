@@ -0,0 +1,174 @@
+#pragma once
+
+#include "vita/anim/mat4.h"
+#include "vita/anim/transform.h"
+#include "vita/anim/vec3.h"
+
+#pragma pack(push, 1)
+
+/// a mat4 without the bottom row, which is always (0, 0, 0, 1) for joint transforms, 48 bytes
+/// instead of 64. Stored row by row so it uploads as a mat3x4 and vec4(p, 1) * m transforms p
+struct affine3x4
+{
+	// same names as mat4, x is the first basis vector and t the translation
+
+	/* row 1 */
+	float xx;
+	float yx;
+	float zx;
+	float tx;
+
+	/* row 2 */
+	float xy;
+	float yy;
+	float zy;
+	float ty;
+
+	/* row 3 */
+	float xz;
+	float yz;
+	float zz;
+	float tz;
+
+	constexpr affine3x4()
+		: xx(1)
+		, yx(0)
+		, zx(0)
+		, tx(0)
+		, xy(0)
+		, yy(1)
+		, zy(0)
+		, ty(0)
+		, xz(0)
+		, yz(0)
+		, zz(1)
+		, tz(0)
+	{
+	}
+
+	/// row by row
+	constexpr affine3x4(
+		float _xx,
+		float _yx,
+		float _zx,
+		float _tx,
+		float _xy,
+		float _yy,
+		float _zy,
+		float _ty,
+		float _xz,
+		float _yz,
+		float _zz,
+		float _tz
+	)
+		: xx(_xx)
+		, yx(_yx)
+		, zx(_zx)
+		, tx(_tx)
+		, xy(_xy)
+		, yy(_yy)
+		, zy(_zy)
+		, ty(_ty)
+		, xz(_xz)
+		, yz(_yz)
+		, zz(_zz)
+		, tz(_tz)
+	{
+	}
+
+	constexpr const float* data_ptr() const
+	{
+		return &xx;
+	}
+};
+
+static_assert(sizeof(affine3x4) == sizeof(float) * 12, "Invalid size");
+#pragma pack(pop)
+
+bool operator==(const affine3x4& a, const affine3x4& b);
+bool operator!=(const affine3x4& a, const affine3x4& b);
+
+/// the same as the mat4 product, the implicit bottom rows are never multiplied
+constexpr affine3x4 operator*(const affine3x4& a, const affine3x4& b)
+{
+	return affine3x4(
+		a.xx * b.xx + a.yx * b.xy + a.zx * b.xz,
+		a.xx * b.yx + a.yx * b.yy + a.zx * b.yz,
+		a.xx * b.zx + a.yx * b.zy + a.zx * b.zz,
+		a.xx * b.tx + a.yx * b.ty + a.zx * b.tz + a.tx,
+
+		a.xy * b.xx + a.yy * b.xy + a.zy * b.xz,
+		a.xy * b.yx + a.yy * b.yy + a.zy * b.yz,
+		a.xy * b.zx + a.yy * b.zy + a.zy * b.zz,
+		a.xy * b.tx + a.yy * b.ty + a.zy * b.tz + a.ty,
+
+		a.xz * b.xx + a.yz * b.xy + a.zz * b.xz,
+		a.xz * b.yx + a.yz * b.yy + a.zz * b.yz,
+		a.xz * b.zx + a.yz * b.zy + a.zz * b.zz,
+		a.xz * b.tx + a.yz * b.ty + a.zz * b.tz + a.tz
+	);
+}
+
+constexpr vec3 get_transformed_vector(const affine3x4& m, const vec3& v)
+{
+	return vec3(
+		m.xx * v.x + m.yx * v.y + m.zx * v.z,
+		m.xy * v.x + m.yy * v.y + m.zy * v.z,
+		m.xz * v.x + m.yz * v.y + m.zz * v.z
+	);
+}
+
+constexpr vec3 get_transformed_point(const affine3x4& m, const vec3& v)
+{
+	return vec3(
+		m.xx * v.x + m.yx * v.y + m.zx * v.z + m.tx,
+		m.xy * v.x + m.yy * v.y + m.zy * v.z + m.ty,
+		m.xz * v.x + m.yz * v.y + m.zz * v.z + m.tz
+	);
+}
+
+/// the identity for a singular matrix, like the mat4 get_inverse
+affine3x4 get_inverse(const affine3x4& m);
+
+/// mat4_from_transform without the bottom row, the rotation comes directly from the quaternion
+constexpr affine3x4 affine3x4_from_transform(const Transform& t)
+{
+	const auto& q = t.rotation;
+	const auto& s = t.scale;
+	const auto& p = t.position;
+	const auto xx = q.x * q.x;
+	const auto yy = q.y * q.y;
+	const auto zz = q.z * q.z;
+	const auto ww = q.w * q.w;
+	return affine3x4(
+		(ww + xx - yy - zz) * s.x,
+		2.0f * (q.x * q.y - q.w * q.z) * s.y,
+		2.0f * (q.x * q.z + q.w * q.y) * s.z,
+		p.x,
+
+		2.0f * (q.x * q.y + q.w * q.z) * s.x,
+		(ww - xx + yy - zz) * s.y,
+		2.0f * (q.y * q.z - q.w * q.x) * s.z,
+		p.y,
+
+		2.0f * (q.x * q.z - q.w * q.y) * s.x,
+		2.0f * (q.y * q.z + q.w * q.x) * s.y,
+		(ww - xx - yy + zz) * s.z,
+		p.z
+	);
+}
+
+/// drops the bottom row, which should be (0, 0, 0, 1)
+constexpr affine3x4 affine3x4_from_mat4(const mat4& m)
+{
+	return affine3x4(
+		m.xx, m.yx, m.zx, m.tx, m.xy, m.yy, m.zy, m.ty, m.xz, m.yz, m.zz, m.tz
+	);
+}
+
+constexpr mat4 mat4_from_affine3x4(const affine3x4& m)
+{
+	return mat4(
+		m.xx, m.xy, m.xz, 0, m.yx, m.yy, m.yz, 0, m.zx, m.zy, m.zz, 0, m.tx, m.ty, m.tz, 1
+	);
+}
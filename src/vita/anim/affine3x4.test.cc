@@ -0,0 +1,41 @@
+#include "catch.hpp"
+
+#include "vita/anim/affine3x4.h"
+
+namespace
+{
+Transform make_transform(float f)
+{
+	return Transform(
+		vec3(0.1f * f, -0.2f * f, 0.5f),
+		quat_from_angle_axis(0.7f * f, get_normalized(vec3(1.0f, f, 2.0f))),
+		vec3(1.0f + 0.1f * f, 1.5f, 0.5f)
+	);
+}
+}  //  namespace
+
+TEST_CASE("affine3x4 matches mat4")
+{
+	const auto a = make_transform(1.0f);
+	const auto b = make_transform(3.0f);
+	const auto ma = mat4_from_transform(a);
+	const auto mb = mat4_from_transform(b);
+
+	CHECK(affine3x4_from_transform(a) == affine3x4_from_mat4(ma));
+	CHECK(mat4_from_affine3x4(affine3x4_from_mat4(ma)) == ma);
+	const auto product = affine3x4_from_transform(a) * affine3x4_from_transform(b);
+	CHECK(product == affine3x4_from_mat4(ma * mb));
+	CHECK(get_inverse(affine3x4_from_mat4(ma)) == affine3x4_from_mat4(get_inverse(ma)));
+	CHECK(affine3x4_from_mat4(ma) * get_inverse(affine3x4_from_mat4(ma)) == affine3x4());
+
+	const auto point = vec3(0.25f, -1.0f, 3.0f);
+	const auto affine = affine3x4_from_mat4(ma);
+	CHECK(get_transformed_point(affine, point) == get_transformed_point(ma, point));
+	CHECK(get_transformed_vector(affine, point) == get_transformed_vector(ma, point));
+}
+
+TEST_CASE("affine3x4 of a singular matrix inverts to the identity")
+{
+	const auto flat = affine3x4(1, 0, 0, 1, 0, 1, 0, 2, 0, 0, 0, 3);
+	CHECK(get_inverse(flat) == affine3x4());
+}
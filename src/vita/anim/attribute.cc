@@ -4,56 +4,131 @@
 #include "vita/anim/vec3.h"
 #include "vita/anim/vec4.h"
 #include "vita/anim/quat.h"
+#include "vita/anim/mat4.h"
+#include "vita/glstate.h"
 
+#include <cstring>
+#include <utility>
+
+/// offset is the byte offset of the first element in the bound buffer
+template<typename T>
+void set_attibute_pointer(unsigned int slot, std::uintptr_t offset);
+
+/// the attribute slots a T takes, a matrix takes one per column
 template<typename T>
-void set_attibute_pointer(unsigned int slot);
+unsigned int get_number_of_slots()
+{
+	return 1;
+}
+
+template<>
+unsigned int get_number_of_slots<mat4>()
+{
+	return 4;
+}
+
+template<>
+void set_attibute_pointer<int>(unsigned int slot, std::uintptr_t offset)
+{
+	glVertexAttribIPointer(slot, 1, GL_INT, 0, reinterpret_cast<const void*>(offset));
+}
 
 template<>
-void set_attibute_pointer<int>(unsigned int slot)
+void set_attibute_pointer<ivec4>(unsigned int slot, std::uintptr_t offset)
 {
-	glVertexAttribIPointer(slot, 1, GL_INT, 0, nullptr);
+	glVertexAttribIPointer(slot, 4, GL_INT, 0, reinterpret_cast<const void*>(offset));
 }
 
 template<>
-void set_attibute_pointer<ivec4>(unsigned int slot)
+void set_attibute_pointer<float>(unsigned int slot, std::uintptr_t offset)
 {
-	glVertexAttribIPointer(slot, 4, GL_INT, 0, nullptr);
+	glVertexAttribPointer(slot, 1, GL_FLOAT, GL_FALSE, 0, reinterpret_cast<const void*>(offset));
 }
 
 template<>
-void set_attibute_pointer<float>(unsigned int slot)
+void set_attibute_pointer<vec2>(unsigned int slot, std::uintptr_t offset)
 {
-	glVertexAttribPointer(slot, 1, GL_FLOAT, GL_FALSE, 0, nullptr);
+	glVertexAttribPointer(slot, 2, GL_FLOAT, GL_FALSE, 0, reinterpret_cast<const void*>(offset));
 }
 
 template<>
-void set_attibute_pointer<vec2>(unsigned int slot)
+void set_attibute_pointer<vec3>(unsigned int slot, std::uintptr_t offset)
 {
-	glVertexAttribPointer(slot, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+	glVertexAttribPointer(slot, 3, GL_FLOAT, GL_FALSE, 0, reinterpret_cast<const void*>(offset));
 }
 
 template<>
-void set_attibute_pointer<vec3>(unsigned int slot)
+void set_attibute_pointer<vec4>(unsigned int slot, std::uintptr_t offset)
 {
-	glVertexAttribPointer(slot, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+	glVertexAttribPointer(slot, 4, GL_FLOAT, GL_FALSE, 0, reinterpret_cast<const void*>(offset));
 }
 
 template<>
-void set_attibute_pointer<vec4>(unsigned int slot)
+void set_attibute_pointer<quat>(unsigned int slot, std::uintptr_t offset)
 {
-	glVertexAttribPointer(slot, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
+	glVertexAttribPointer(slot, 4, GL_FLOAT, GL_FALSE, 0, reinterpret_cast<const void*>(offset));
 }
 
 template<>
-void set_attibute_pointer<quat>(unsigned int slot)
+void set_attibute_pointer<mat4>(unsigned int slot, std::uintptr_t offset)
+{
+	for (unsigned int column = 0; column < 4; ++column)
+	{
+		const std::uintptr_t column_offset = offset + column * sizeof(vec4);
+		glVertexAttribPointer(
+			slot + column,
+			4,
+			GL_FLOAT,
+			GL_FALSE,
+			sizeof(mat4),
+			reinterpret_cast<const void*>(column_offset)
+		);
+	}
+}
+
+namespace
+{
+void delete_fence(void*& fence)
 {
-	glVertexAttribPointer(slot, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
+	if (fence != nullptr)
+	{
+		glDeleteSync(static_cast<GLsync>(fence));
+		fence = nullptr;
+	}
 }
 
+void wait_for_fence(void*& fence)
+{
+	if (fence == nullptr)
+	{
+		return;
+	}
+
+	// only waits if the gpu is more than STREAMING_REGIONS - 1 frames behind
+	constexpr GLuint64 TIMEOUT_NS = 1000000;
+	auto flags = GLbitfield{GL_SYNC_FLUSH_COMMANDS_BIT};
+	while (true)
+	{
+		const auto result = glClientWaitSync(static_cast<GLsync>(fence), flags, TIMEOUT_NS);
+		if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED
+			|| result == GL_WAIT_FAILED)
+		{
+			break;
+		}
+		flags = 0;
+	}
+	delete_fence(fence);
+}
+}  //  namespace
+
 template<typename T>
 Attribute<T>::Attribute()
 	: handle(0)
 	, count(0)
+	, is_streaming(false)
+	, region_capacity(0)
+	, region(0)
+	, fences{}
 {
 	glGenBuffers(1, &handle);
 }
@@ -61,18 +136,121 @@ Attribute<T>::Attribute()
 template<typename T>
 Attribute<T>::~Attribute()
 {
-	glDeleteBuffers(1, &handle);
+	for (auto& fence: fences)
+	{
+		delete_fence(fence);
+	}
+	if (handle != 0)
+	{
+		glstate::invalidate();
+		glDeleteBuffers(1, &handle);
+	}
+}
+
+template<typename T>
+Attribute<T>::Attribute(Attribute&& other) noexcept
+	: handle(std::exchange(other.handle, 0))
+	, count(std::exchange(other.count, 0))
+	, is_streaming(std::exchange(other.is_streaming, false))
+	, region_capacity(std::exchange(other.region_capacity, 0))
+	, region(std::exchange(other.region, 0))
+	, fences(std::exchange(other.fences, {}))
+{
+}
+
+template<typename T>
+Attribute<T>& Attribute<T>::operator=(Attribute&& other) noexcept
+{
+	if (this != &other)
+	{
+		Attribute old{std::move(*this)};
+		handle = std::exchange(other.handle, 0);
+		count = std::exchange(other.count, 0);
+		is_streaming = std::exchange(other.is_streaming, false);
+		region_capacity = std::exchange(other.region_capacity, 0);
+		region = std::exchange(other.region, 0);
+		fences = std::exchange(other.fences, {});
+	}
+	return *this;
+}
+
+template<typename T>
+void Attribute<T>::enable_streaming()
+{
+	is_streaming = true;
 }
 
 template<typename T>
 void Attribute<T>::set_ptr(T* inputArray, unsigned int arrayLength)
 {
+	if (is_streaming)
+	{
+		stream(inputArray, arrayLength);
+		return;
+	}
+
 	count = arrayLength;
 	const auto size = sizeof(T);
 
-	glBindBuffer(GL_ARRAY_BUFFER, handle);
+	glstate::bind_buffer(GL_ARRAY_BUFFER, handle);
 	glBufferData(GL_ARRAY_BUFFER, size * count, inputArray, GL_STREAM_DRAW);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glstate::count_calls(1);
+}
+
+template<typename T>
+void Attribute<T>::stream(const T* inputArray, unsigned int arrayLength)
+{
+	count = arrayLength;
+	glstate::bind_buffer(GL_ARRAY_BUFFER, handle);
+	if (arrayLength > region_capacity)
+	{
+		// grow, the old storage is orphaned so nothing needs to be waited on
+		for (auto& fence: fences)
+		{
+			delete_fence(fence);
+		}
+		region_capacity = arrayLength;
+		region = 0;
+		glBufferData(
+			GL_ARRAY_BUFFER,
+			static_cast<GLsizeiptr>(sizeof(T) * region_capacity * STREAMING_REGIONS),
+			nullptr,
+			GL_STREAM_DRAW
+		);
+		glstate::count_calls(1);
+	}
+	else
+	{
+		// the draws issued so far read the current region
+		fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		region = (region + 1) % STREAMING_REGIONS;
+		wait_for_fence(fences[region]);
+		glstate::count_calls(3);
+	}
+
+	const auto offset = static_cast<GLintptr>(sizeof(T) * region_capacity * region);
+	const auto size = static_cast<GLsizeiptr>(sizeof(T) * arrayLength);
+	if (size > 0)
+	{
+		// glad is generated for 3.3 so there is no persistent mapping, the fence makes an
+		// unsynchronized map safe instead
+		void* target = glMapBufferRange(
+			GL_ARRAY_BUFFER,
+			offset,
+			size,
+			GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT
+		);
+		if (target != nullptr)
+		{
+			std::memcpy(target, inputArray, static_cast<std::size_t>(size));
+			glUnmapBuffer(GL_ARRAY_BUFFER);
+		}
+		else
+		{
+			glBufferSubData(GL_ARRAY_BUFFER, offset, size, inputArray);
+		}
+		glstate::count_calls(2);
+	}
 }
 
 template<typename T>
@@ -84,18 +262,37 @@ void Attribute<T>::set(std::vector<T>& input)
 template<typename T>
 void Attribute<T>::bind_to(unsigned int slot)
 {
-	glBindBuffer(GL_ARRAY_BUFFER, handle);
-	glEnableVertexAttribArray(slot);
-	set_attibute_pointer<T>(slot);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glstate::bind_buffer(GL_ARRAY_BUFFER, handle);
+	for (unsigned int index = 0; index < get_number_of_slots<T>(); ++index)
+	{
+		glEnableVertexAttribArray(slot + index);
+	}
+	const auto offset = is_streaming ? sizeof(T) * region_capacity * region : std::size_t{0};
+	set_attibute_pointer<T>(slot, offset);
+	glstate::count_calls(2 * get_number_of_slots<T>());
+}
+
+template<typename T>
+void Attribute<T>::bind_to_instanced(unsigned int slot, unsigned int divisor)
+{
+	bind_to(slot);
+	for (unsigned int index = 0; index < get_number_of_slots<T>(); ++index)
+	{
+		glVertexAttribDivisor(slot + index, divisor);
+	}
+	glstate::count_calls(get_number_of_slots<T>());
 }
 
 template<typename T>
 void Attribute<T>::unbind_from(unsigned int slot)
 {
-	glBindBuffer(GL_ARRAY_BUFFER, handle);
-	glDisableVertexAttribArray(slot);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	for (unsigned int index = 0; index < get_number_of_slots<T>(); ++index)
+	{
+		// the divisor sticks to the slot, reset it for the next non instanced attribute
+		glVertexAttribDivisor(slot + index, 0);
+		glDisableVertexAttribArray(slot + index);
+	}
+	glstate::count_calls(2 * get_number_of_slots<T>());
 }
 
 template struct Attribute<int>;
@@ -105,3 +302,4 @@ template struct Attribute<vec3>;
 template struct Attribute<vec4>;
 template struct Attribute<ivec4>;
 template struct Attribute<quat>;
+template struct Attribute<mat4>;
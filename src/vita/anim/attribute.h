@@ -1,23 +1,47 @@
 #pragma once
 
+/// the regions a streaming attribute cycles through, one drawn by the gpu, one queued and one
+/// written by the cpu
+constexpr unsigned int STREAMING_REGIONS = 3;
+
 template<typename T>
 struct Attribute
 {
 	unsigned int handle;
 	unsigned int count;
 
+	/// see enable_streaming
+	bool is_streaming;
+	unsigned int region_capacity;
+	unsigned int region;
+
+	/// GLsync, set when the gpu might still be reading a region
+	std::array<void*, STREAMING_REGIONS> fences;
+
 	Attribute(const Attribute& other) = delete;
 	void operator=(const Attribute& other) = delete;
 
-	Attribute(Attribute&& other) = delete;
-	void operator=(Attribute&& other) = delete;
+	/// the moved from attribute owns nothing
+	Attribute(Attribute&& other) noexcept;
+	Attribute& operator=(Attribute&& other) noexcept;
 
 	Attribute();
 	~Attribute();
 
+	/// for data that changes every frame, set writes to the next region of a ring instead of
+	/// reallocating the buffer and only waits if the gpu is still reading that region
+	void enable_streaming();
+
 	void set_ptr(T* inputArray, unsigned int arrayLength);
 	void set(std::vector<T>& input);
 
+	/// set_ptr for a streaming attribute
+	void stream(const T* inputArray, unsigned int arrayLength);
+
 	void bind_to(unsigned int slot);
+
+	/// advance once per divisor instances instead of once per vertex
+	void bind_to_instanced(unsigned int slot, unsigned int divisor = 1);
+
 	void unbind_from(unsigned int slot);
 };
@@ -0,0 +1,85 @@
+#include "vita/anim/bakedanimation.h"
+
+#include "vita/assert.h"
+#include "vita/anim/mesh.h"
+
+#include <cmath>
+#include <cstring>
+
+unsigned int BakedAnimation::get_width() const
+{
+	return static_cast<unsigned int>(number_of_joints * 4);
+}
+
+unsigned int BakedAnimation::get_height() const
+{
+	return number_of_joints == 0 ? 0 : static_cast<unsigned int>(texels.size() / 4 / get_width());
+}
+
+TextureFloatData BakedAnimation::get_texture_data() const
+{
+	return {get_width(), get_height(), texels.data()};
+}
+
+vec3 BakedAnimation::get_instance(std::size_t clip, float time) const
+{
+	ASSERT(clip < clips.size());
+	const auto& range = clips[clip];
+	return vec3(
+		static_cast<float>(range.first_row),
+		static_cast<float>(range.number_of_frames),
+		(time - range.start_time) * range.frames_per_second
+	);
+}
+
+BakedAnimation bake_animation(
+	const std::vector<Clip>& clips, const Skeleton& skeleton, float samples_per_second
+)
+{
+	ASSERT(samples_per_second > 0.0f);
+
+	BakedAnimation baked;
+	baked.number_of_joints = skeleton.rest_pose.size();
+	baked.samples_per_second = samples_per_second;
+
+	const auto floats_per_row = baked.number_of_joints * 16;
+	auto pose = skeleton.rest_pose;
+	std::vector<mat4> pose_palette;
+	std::vector<mat4> skin_palette;
+
+	for (const auto& clip: clips)
+	{
+		const auto duration = clip.GetDuration();
+
+		BakedClipRange range;
+		range.first_row = baked.clips.empty()
+							? 0
+							: baked.clips.back().first_row + baked.clips.back().number_of_frames;
+		range.start_time = clip.duration.start;
+		// one more than the whole frames so the last sample lands on the end of the clip, spread
+		// evenly since the shader interpolates as if they were
+		range.number_of_frames
+			= static_cast<std::size_t>(std::ceil(duration * samples_per_second)) + 1;
+		const auto last_frame = static_cast<float>(range.number_of_frames - 1);
+		range.frames_per_second = duration > 0.0f ? last_frame / duration : 0.0f;
+		baked.clips.emplace_back(range);
+		baked.texels.resize((range.first_row + range.number_of_frames) * floats_per_row);
+
+		for (std::size_t frame = 0; frame < range.number_of_frames; ++frame)
+		{
+			const auto offset
+				= duration > 0.0f ? duration * static_cast<float>(frame) / last_frame : 0.0f;
+			clip.sample_to_pose(pose, clip.duration.start + offset);
+			calc_matrix_palette(pose, pose_palette);
+			calc_skin_palette(pose_palette, skeleton.inverse_bind_pose, skin_palette);
+
+			std::memcpy(
+				&baked.texels[(range.first_row + frame) * floats_per_row],
+				skin_palette.data(),
+				skin_palette.size() * sizeof(mat4)
+			);
+		}
+	}
+
+	return baked;
+}
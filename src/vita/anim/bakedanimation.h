@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+
+#include "vita/anim/clip.h"
+#include "vita/anim/skeleton.h"
+#include "vita/anim/texture.h"
+#include "vita/anim/vec3.h"
+
+/// the rows of a BakedAnimation one clip was sampled to
+struct BakedClipRange
+{
+	std::size_t first_row = 0;
+	std::size_t number_of_frames = 0;
+	float start_time = 0.0f;
+	/// the frames evenly split the clip so this is at least the samples_per_second of the bake
+	float frames_per_second = 0.0f;
+};
+
+/// clips sampled at a fixed rate into skin palettes, laid out to be uploaded as a float texture
+/// with one row per sampled frame and 4 texels (the columns of a mat4) per joint
+struct BakedAnimation
+{
+	std::size_t number_of_joints = 0;
+	float samples_per_second = 0.0f;
+	std::vector<BakedClipRange> clips;
+	/// RGBA floats
+	std::vector<float> texels;
+
+	unsigned int get_width() const;
+	unsigned int get_height() const;
+	TextureFloatData get_texture_data() const;
+
+	/// the first row, the number of frames and the fractional frame, what the baked shader needs
+	/// per instance to sample the clip at the time
+	vec3 get_instance(std::size_t clip, float time) const;
+};
+
+BakedAnimation bake_animation(
+	const std::vector<Clip>& clips, const Skeleton& skeleton, float samples_per_second
+);
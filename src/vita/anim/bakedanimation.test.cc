@@ -0,0 +1,83 @@
+#include "catch.hpp"
+
+#include "vita/anim/bakedanimation.h"
+#include "vita/anim/mesh.h"
+
+#include <cmath>
+
+TEST_CASE("baked animation rows are the skin palettes of the sampled frames")
+{
+	Pose rest_pose(3);
+	rest_pose[1].parent = 0;
+	rest_pose[2].parent = 1;
+	for (auto& joint: rest_pose)
+	{
+		joint.local.position = vec3(0.0f, 1.0f, 0.0f);
+	}
+	const auto skeleton = Skeleton(rest_pose, rest_pose, std::vector<std::string>(3));
+
+	std::vector<Frame<vec3>> frames;
+	frames.emplace_back(0.5f, vec3(), vec3(), vec3(0.0f, 1.0f, 0.0f));
+	frames.emplace_back(1.5f, vec3(), vec3(), vec3(2.0f, 1.0f, 0.0f));
+
+	std::vector<Clip> clips(2);
+	clips[0][1].position.frames = frames;
+	clips[0].duration = duration_from_tracks(clips[0].tracks);
+	clips[1][2].position.frames = frames;
+	clips[1].duration = duration_from_tracks(clips[1].tracks);
+
+	const auto baked = bake_animation(clips, skeleton, 10.0f);
+	REQUIRE(baked.clips.size() == 2);
+	CHECK(baked.clips[0].number_of_frames == 11);
+	CHECK(baked.clips[1].first_row == 11);
+	CHECK(baked.get_width() == 12);
+	CHECK(baked.get_height() == 22);
+
+	const auto instance = baked.get_instance(1, 0.8f);
+	CHECK(instance.x == 11.0f);
+	CHECK(instance.y == 11.0f);
+	CHECK(std::abs(instance.z - 3.0f) < 0.0001f);
+
+	auto pose = rest_pose;
+	clips[1].sample_to_pose(pose, 0.8f);
+	std::vector<mat4> skin_palette;
+	calc_skin_palette(calc_matrix_palette(pose), skeleton.inverse_bind_pose, skin_palette);
+
+	const auto* row = &baked.texels[(11 + 3) * 3 * 16];
+	for (std::size_t joint = 0; joint < 3; joint += 1)
+	{
+		for (int element = 0; element < 16; element += 1)
+		{
+			const auto texel = row[joint * 16 + static_cast<std::size_t>(element)];
+			CHECK(std::abs(texel - skin_palette[joint][element]) < 0.0001f);
+		}
+	}
+}
+
+TEST_CASE("baked animation frames are spread evenly over the clip")
+{
+	Pose rest_pose(1);
+	const auto skeleton = Skeleton(rest_pose, rest_pose, std::vector<std::string>(1));
+
+	// 1.05 seconds doesn't divide into whole samples at 10 a second
+	std::vector<Clip> clips(1);
+	clips[0][0].position.frames.emplace_back(0.0f, vec3(), vec3(), vec3(0.0f, 0.0f, 0.0f));
+	clips[0][0].position.frames.emplace_back(1.05f, vec3(), vec3(), vec3(1.05f, 0.0f, 0.0f));
+	clips[0].duration = duration_from_tracks(clips[0].tracks);
+	// a looping clip wraps the end back to the first pose
+	clips[0].is_looping = false;
+
+	const auto baked = bake_animation(clips, skeleton, 10.0f);
+	REQUIRE(baked.clips.size() == 1);
+	CHECK(baked.clips[0].number_of_frames == 12);
+	CHECK(std::abs(baked.clips[0].frames_per_second - 11.0f / 1.05f) < 0.0001f);
+
+	// the translation moves linearly so every frame should move it the same amount
+	for (std::size_t frame = 0; frame < 12; frame += 1)
+	{
+		const auto tx = baked.texels[frame * 16 + 12];
+		CHECK(std::abs(tx - 1.05f * static_cast<float>(frame) / 11.0f) < 0.0001f);
+	}
+
+	CHECK(std::abs(baked.get_instance(0, 1.05f).z - 11.0f) < 0.0001f);
+}
@@ -1,14 +1,19 @@
 #include "vita/anim/clip.h"
 
+#include "vita/str.h"
+
 #include <cmath>
+#include <algorithm>
 
-Clip::Clip()
+template<typename TRACK>
+TClip<TRACK>::TClip()
 {
 	name = "No name given";
 	is_looping = true;
 }
 
-float AdjustTimeToFitRange(const Clip& self, float inTime)
+template<typename TRACK>
+float AdjustTimeToFitRange(const TClip<TRACK>& self, float inTime)
 {
 	const auto& span = self.duration;
 
@@ -40,7 +45,8 @@ float AdjustTimeToFitRange(const Clip& self, float inTime)
 	return inTime;
 }
 
-float Clip::sample_to_pose(Pose& outPose, float time) const
+template<typename TRACK>
+float TClip<TRACK>::sample_to_pose(Pose& outPose, float time) const
 {
 	if (GetDuration() == 0.0f)
 	{
@@ -58,7 +64,38 @@ float Clip::sample_to_pose(Pose& outPose, float time) const
 	return time;
 }
 
-ClipDuration duration_from_tracks(const std::vector<TransformTrack>& tracks)
+template<typename TRACK>
+float TClip<TRACK>::sample_to_pose(Pose& outPose, float time, ClipCursor& cursor) const
+{
+	if (GetDuration() == 0.0f)
+	{
+		return 0.0f;
+	}
+	time = AdjustTimeToFitRange(*this, time);
+
+	const auto size = tracks.size();
+	cursor.resize(size);
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		const auto joint = tracks[i].id;
+		const auto local = outPose[joint].local;
+		outPose[joint].local = tracks[i].get_sample(local, time, is_looping, cursor[i]);
+	}
+	return time;
+}
+
+template<typename TRACK>
+float TClip<TRACK>::adjust_time_to_fit(float time) const
+{
+	if (GetDuration() == 0.0f)
+	{
+		return 0.0f;
+	}
+	return AdjustTimeToFitRange(*this, time);
+}
+
+template<typename TRACK>
+ClipDuration duration_from_tracks(const std::vector<TRACK>& tracks)
 {
 	float start_time = 0.0f;
 	float end_time = 0.0f;
@@ -89,7 +126,8 @@ ClipDuration duration_from_tracks(const std::vector<TransformTrack>& tracks)
 	return {start_time, end_time};
 }
 
-TransformTrack& Clip::operator[](std::size_t joint)
+template<typename TRACK>
+TRACK& TClip<TRACK>::operator[](std::size_t joint)
 {
 	const auto size = tracks.size();
 	for (std::size_t i = 0; i < size; ++i)
@@ -105,7 +143,178 @@ TransformTrack& Clip::operator[](std::size_t joint)
 	return tracks[tracks.size() - 1];
 }
 
-float Clip::GetDuration() const
+template<typename TRACK>
+float TClip<TRACK>::GetDuration() const
 {
 	return duration.end - duration.start;
 }
+
+template<typename TRACK>
+void remap_joints(TClip<TRACK>& clip, const JointOrder& order)
+{
+	for (auto& track: clip.tracks)
+	{
+		track.id = order.new_index[track.id];
+	}
+
+	// sample_to_pose writes the joints in track order
+	std::stable_sort(
+		clip.tracks.begin(),
+		clip.tracks.end(),
+		[](const TRACK& lhs, const TRACK& rhs) { return lhs.id < rhs.id; }
+	);
+}
+
+FastClip optimize_clip(const Clip& clip)
+{
+	FastClip result;
+
+	result.name = clip.name;
+	result.is_looping = clip.is_looping;
+
+	const auto size = clip.tracks.size();
+	result.tracks.reserve(size);
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		result.tracks.emplace_back(optimize_transform_track(clip.tracks[i]));
+	}
+	result.duration = duration_from_tracks(result.tracks);
+
+	return result;
+}
+
+PackedClip pack_clip(const Clip& clip)
+{
+	PackedClip result;
+
+	result.name = clip.name;
+	result.is_looping = clip.is_looping;
+
+	const auto size = clip.tracks.size();
+	result.tracks.reserve(size);
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		result.tracks.emplace_back(pack_transform_track(clip.tracks[i]));
+	}
+	result.duration = duration_from_tracks(result.tracks);
+
+	return result;
+}
+
+CompressedClip compress_clip(const Clip& clip)
+{
+	CompressedClip result;
+
+	result.name = clip.name;
+	result.is_looping = clip.is_looping;
+
+	const auto size = clip.tracks.size();
+	result.tracks.reserve(size);
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		result.tracks.emplace_back(compress_transform_track(clip.tracks[i]));
+	}
+	result.duration = duration_from_tracks(result.tracks);
+
+	return result;
+}
+
+constexpr float COMPRESSION_REPORT_SAMPLES_PER_SECOND = 120.0f;
+
+ClipCompressionReport make_compression_report(
+	const Clip& original, const CompressedClip& compressed, const Pose& rest_pose
+)
+{
+	ClipCompressionReport report;
+
+	for (const auto& track: original.tracks)
+	{
+		report.original_bytes += sizeof(TransformTrack)
+							   + track.position.frames.size() * sizeof(VectorFrame)
+							   + track.rotation.frames.size() * sizeof(QuaternionFrame)
+							   + track.scale.frames.size() * sizeof(VectorFrame);
+	}
+
+	for (const auto& track: compressed.tracks)
+	{
+		report.compressed_bytes += sizeof(CompressedTransformTrack)
+								 + track.position.get_memory_usage()
+								 + track.rotation.get_memory_usage()
+								 + track.scale.get_memory_usage();
+		if (track.position.is_valid())
+		{
+			report.position_error_bound
+				= std::max(report.position_error_bound, track.position.get_error_bound());
+		}
+		if (track.rotation.is_valid())
+		{
+			report.rotation_error_bound
+				= std::max(report.rotation_error_bound, track.rotation.get_error_bound());
+		}
+		if (track.scale.is_valid())
+		{
+			report.scale_error_bound
+				= std::max(report.scale_error_bound, track.scale.get_error_bound());
+		}
+	}
+
+	const auto duration = original.GetDuration();
+	const auto number_of_samples
+		= static_cast<std::size_t>(std::ceil(duration * COMPRESSION_REPORT_SAMPLES_PER_SECOND)) + 1;
+	for (std::size_t sample = 0; sample < number_of_samples; ++sample)
+	{
+		const auto t = number_of_samples > 1
+						 ? static_cast<float>(sample) / static_cast<float>(number_of_samples - 1)
+						 : 0.0f;
+		const auto time = original.duration.start + t * duration;
+
+		auto original_pose = rest_pose;
+		auto compressed_pose = rest_pose;
+		original.sample_to_pose(original_pose, time);
+		compressed.sample_to_pose(compressed_pose, time);
+
+		for (std::size_t joint = 0; joint < rest_pose.size(); ++joint)
+		{
+			const auto& lhs = original_pose[joint].local;
+			const auto& rhs = compressed_pose[joint].local;
+			report.max_position_error = std::max(
+				report.max_position_error, std::sqrt(get_length_sq(lhs.position - rhs.position))
+			);
+			report.max_rotation_error = std::max(
+				report.max_rotation_error, get_angle_between(lhs.rotation, rhs.rotation)
+			);
+			report.max_scale_error
+				= std::max(report.max_scale_error, std::sqrt(get_length_sq(lhs.scale - rhs.scale)));
+		}
+	}
+
+	return report;
+}
+
+std::string to_string(const ClipCompressionReport& report)
+{
+	const auto saved = report.original_bytes > report.compressed_bytes
+						 ? report.original_bytes - report.compressed_bytes
+						 : 0;
+	return Str() << report.original_bytes << " -> " << report.compressed_bytes << " bytes ("
+				 << saved << " saved), position error " << report.max_position_error << " (bound "
+				 << report.position_error_bound << "), rotation error "
+				 << report.max_rotation_error << " rad (bound " << report.rotation_error_bound
+				 << "), scale error " << report.max_scale_error << " (bound "
+				 << report.scale_error_bound << ")";
+}
+
+template struct TClip<TransformTrack>;
+template struct TClip<FastTransformTrack>;
+template struct TClip<PackedTransformTrack>;
+template struct TClip<CompressedTransformTrack>;
+
+template void remap_joints(Clip& clip, const JointOrder& order);
+template void remap_joints(FastClip& clip, const JointOrder& order);
+template void remap_joints(PackedClip& clip, const JointOrder& order);
+template void remap_joints(CompressedClip& clip, const JointOrder& order);
+
+template ClipDuration duration_from_tracks(const std::vector<TransformTrack>& tracks);
+template ClipDuration duration_from_tracks(const std::vector<FastTransformTrack>& tracks);
+template ClipDuration duration_from_tracks(const std::vector<PackedTransformTrack>& tracks);
+template ClipDuration duration_from_tracks(const std::vector<CompressedTransformTrack>& tracks);
@@ -12,19 +12,63 @@ struct ClipDuration
 	float end = 0.0f;
 };
 
-struct Clip
+/// one cursor per track, keep one per playing instance to make sequential sampling cheap
+using ClipCursor = std::vector<TransformTrackCursor>;
+
+template<typename TRACK>
+struct TClip
 {
-	std::vector<TransformTrack> tracks;
+	std::vector<TRACK> tracks;
 	std::string name;
 	ClipDuration duration;
 	bool is_looping;
 
-	Clip();
+	TClip();
 
 	float sample_to_pose(Pose& outPose, float inTime) const;
-	TransformTrack& operator[](std::size_t index);
+	float sample_to_pose(Pose& outPose, float inTime, ClipCursor& cursor) const;
+
+	/// loop or clamp the time to the clip, the same time sample_to_pose returns
+	float adjust_time_to_fit(float time) const;
+	TRACK& operator[](std::size_t index);
 
 	float GetDuration() const;
 };
 
-ClipDuration duration_from_tracks(const std::vector<TransformTrack>& tracks);
+typedef TClip<TransformTrack> Clip;
+typedef TClip<FastTransformTrack> FastClip;
+typedef TClip<PackedTransformTrack> PackedClip;
+typedef TClip<CompressedTransformTrack> CompressedClip;
+
+template<typename TRACK>
+ClipDuration duration_from_tracks(const std::vector<TRACK>& tracks);
+
+/// change the joint every track animates after the skeleton was reordered
+template<typename TRACK>
+void remap_joints(TClip<TRACK>& clip, const JointOrder& order);
+
+FastClip optimize_clip(const Clip& clip);
+PackedClip pack_clip(const Clip& clip);
+CompressedClip compress_clip(const Clip& clip);
+
+/// how much memory a compressed clip saves and how far from the original it samples
+struct ClipCompressionReport
+{
+	std::size_t original_bytes = 0;
+	std::size_t compressed_bytes = 0;
+
+	/// the largest error the quantization can introduce, rotations are in radians
+	float position_error_bound = 0.0f;
+	float rotation_error_bound = 0.0f;
+	float scale_error_bound = 0.0f;
+
+	/// the largest error found when sampling both clips
+	float max_position_error = 0.0f;
+	float max_rotation_error = 0.0f;
+	float max_scale_error = 0.0f;
+};
+
+ClipCompressionReport make_compression_report(
+	const Clip& original, const CompressedClip& compressed, const Pose& rest_pose
+);
+std::string to_string(const ClipCompressionReport& report);
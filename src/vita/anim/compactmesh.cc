@@ -0,0 +1,350 @@
+#include "vita/anim/compactmesh.h"
+
+#include "vita/assert.h"
+#include "vita/glstate.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+namespace
+{
+float sign_not_zero(float value)
+{
+	return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+std::int16_t to_snorm16(float value)
+{
+	const auto clamped = std::fmax(-1.0f, std::fmin(1.0f, value));
+	return static_cast<std::int16_t>(std::lround(clamped * 32767.0f));
+}
+
+float from_snorm16(std::int16_t value)
+{
+	return std::fmax(-1.0f, static_cast<float>(value) / 32767.0f);
+}
+
+/// round the bits shifted out of a half mantissa to nearest even
+std::uint32_t round_shifted(std::uint32_t mantissa, std::uint32_t shift)
+{
+	auto result = mantissa >> shift;
+	const auto rest = mantissa & ((1u << shift) - 1u);
+	const auto halfway = 1u << (shift - 1u);
+	if (rest > halfway || (rest == halfway && (result & 1u) != 0))
+	{
+		result += 1;
+	}
+	return result;
+}
+
+std::uint8_t to_joint(int joint)
+{
+	ASSERT(joint >= 0 && static_cast<std::size_t>(joint) < MAX_PALETTE_JOINTS);
+	return static_cast<std::uint8_t>(joint);
+}
+
+void upload_vertices(const Mesh& mesh, unsigned int vertex_buffer)
+{
+	using Vertex = CompactVertex;
+	const auto vertices = make_compact_vertices(mesh);
+
+	glstate::bind_buffer(GL_ARRAY_BUFFER, vertex_buffer);
+	glBufferData(
+		GL_ARRAY_BUFFER,
+		static_cast<GLsizeiptr>(sizeof(Vertex) * vertices.size()),
+		vertices.data(),
+		GL_STATIC_DRAW
+	);
+
+	const auto stride = static_cast<GLsizei>(sizeof(Vertex));
+	const auto pointer = [](std::size_t offset)
+	{
+		return reinterpret_cast<const void*>(offset);
+	};
+	glVertexAttribPointer(
+		COMPACT_POSITION_SLOT, 3, GL_FLOAT, GL_FALSE, stride, pointer(offsetof(Vertex, position))
+	);
+	glVertexAttribPointer(
+		COMPACT_NORMAL_SLOT, 2, GL_SHORT, GL_TRUE, stride, pointer(offsetof(Vertex, normal))
+	);
+	glVertexAttribPointer(
+		COMPACT_TEXCOORD_SLOT,
+		2,
+		GL_HALF_FLOAT,
+		GL_FALSE,
+		stride,
+		pointer(offsetof(Vertex, texcoord))
+	);
+	glVertexAttribPointer(
+		COMPACT_WEIGHTS_SLOT,
+		4,
+		GL_UNSIGNED_BYTE,
+		GL_TRUE,
+		stride,
+		pointer(offsetof(Vertex, weights))
+	);
+	glVertexAttribIPointer(
+		COMPACT_JOINTS_SLOT, 4, GL_UNSIGNED_BYTE, stride, pointer(offsetof(Vertex, joints))
+	);
+
+	for (const auto slot:
+		 {COMPACT_POSITION_SLOT,
+		  COMPACT_NORMAL_SLOT,
+		  COMPACT_TEXCOORD_SLOT,
+		  COMPACT_WEIGHTS_SLOT,
+		  COMPACT_JOINTS_SLOT})
+	{
+		glEnableVertexAttribArray(slot);
+	}
+}
+}  //  namespace
+
+std::array<std::int16_t, 2> encode_octahedral_normal(const vec3& normal)
+{
+	const auto length = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+	if (length <= 0.0f)
+	{
+		return {0, 0};
+	}
+
+	auto x = normal.x / length;
+	auto y = normal.y / length;
+	if (normal.z < 0.0f)
+	{
+		// fold the lower half over the diagonals
+		const auto folded_x = (1.0f - std::abs(y)) * sign_not_zero(x);
+		const auto folded_y = (1.0f - std::abs(x)) * sign_not_zero(y);
+		x = folded_x;
+		y = folded_y;
+	}
+	return {to_snorm16(x), to_snorm16(y)};
+}
+
+vec3 decode_octahedral_normal(const std::array<std::int16_t, 2>& encoded)
+{
+	auto x = from_snorm16(encoded[0]);
+	auto y = from_snorm16(encoded[1]);
+	const auto z = 1.0f - std::abs(x) - std::abs(y);
+	const auto t = std::fmax(-z, 0.0f);
+	x += x >= 0.0f ? -t : t;
+	y += y >= 0.0f ? -t : t;
+	return get_normalized(vec3(x, y, z));
+}
+
+std::uint16_t float_to_half(float value)
+{
+	std::uint32_t bits = 0;
+	std::memcpy(&bits, &value, sizeof(bits));
+
+	const auto sign = (bits >> 16) & 0x8000u;
+	const auto magnitude = bits & 0x7fffffffu;
+	if (magnitude > 0x7f800000u)
+	{
+		return static_cast<std::uint16_t>(sign | 0x7e00u);
+	}
+
+	const auto exponent = static_cast<int>(magnitude >> 23) - 127 + 15;
+	const auto mantissa = magnitude & 0x7fffffu;
+	if (exponent >= 31)
+	{
+		return static_cast<std::uint16_t>(sign | 0x7c00u);
+	}
+	if (exponent <= 0)
+	{
+		if (exponent < -10)
+		{
+			return static_cast<std::uint16_t>(sign);
+		}
+		const auto shift = static_cast<std::uint32_t>(14 - exponent);
+		return static_cast<std::uint16_t>(sign | round_shifted(mantissa | 0x800000u, shift));
+	}
+
+	// a mantissa that rounds up carries into the exponent, which is still the correct half
+	const auto half = (static_cast<std::uint32_t>(exponent) << 10) + round_shifted(mantissa, 13);
+	return static_cast<std::uint16_t>(sign | half);
+}
+
+float half_to_float(std::uint16_t half)
+{
+	const auto sign = (static_cast<std::uint32_t>(half) & 0x8000u) << 16;
+	const auto exponent = (static_cast<std::uint32_t>(half) >> 10) & 0x1fu;
+	const auto mantissa = static_cast<std::uint32_t>(half) & 0x3ffu;
+
+	if (exponent == 0)
+	{
+		const auto value = std::ldexp(static_cast<float>(mantissa), -24);
+		return sign != 0 ? -value : value;
+	}
+
+	const auto bits = exponent == 31 ? sign | 0x7f800000u | (mantissa << 13)
+									 : sign | ((exponent + 112) << 23) | (mantissa << 13);
+	float result = 0.0f;
+	std::memcpy(&result, &bits, sizeof(result));
+	return result;
+}
+
+std::array<std::uint8_t, 4> encode_weights(const vec4& weights)
+{
+	const float source[4] = {weights.x, weights.y, weights.z, weights.w};
+	const auto sum = source[0] + source[1] + source[2] + source[3];
+	if (sum <= 0.0f)
+	{
+		return {0, 0, 0, 0};
+	}
+
+	int quantized[4] = {};
+	int total = 0;
+	std::size_t largest = 0;
+	for (std::size_t i = 0; i < 4; ++i)
+	{
+		quantized[i] = static_cast<int>(std::lround(std::fmax(0.0f, source[i]) / sum * 255.0f));
+		total += quantized[i];
+		if (source[i] > source[largest])
+		{
+			largest = i;
+		}
+	}
+	quantized[largest] += 255 - total;
+
+	std::array<std::uint8_t, 4> result;
+	for (std::size_t i = 0; i < 4; ++i)
+	{
+		result[i] = static_cast<std::uint8_t>(quantized[i]);
+	}
+	return result;
+}
+
+std::vector<CompactVertex> make_compact_vertices(const Mesh& mesh)
+{
+	const auto size = mesh.position.size();
+	std::vector<CompactVertex> vertices(size);
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		auto& vertex = vertices[i];
+		vertex.position = mesh.position[i];
+		vertex.normal = i < mesh.normal.size() ? encode_octahedral_normal(mesh.normal[i])
+											   : std::array<std::int16_t, 2>{0, 0};
+		vertex.texcoord = {0, 0};
+		if (i < mesh.texcoord.size())
+		{
+			vertex.texcoord = {
+				float_to_half(mesh.texcoord[i].x), float_to_half(mesh.texcoord[i].y)
+			};
+		}
+		vertex.weights = i < mesh.weights.size() ? encode_weights(mesh.weights[i])
+												 : std::array<std::uint8_t, 4>{0, 0, 0, 0};
+		vertex.joints = {0, 0, 0, 0};
+		if (i < mesh.influences.size())
+		{
+			const auto& joints = mesh.influences[i];
+			vertex.joints = {
+				to_joint(joints.x),
+				to_joint(joints.y),
+				to_joint(joints.z),
+				to_joint(joints.w)
+			};
+		}
+	}
+	return vertices;
+}
+
+CompactMesh::CompactMesh()
+	: vertex_buffer(0)
+	, vertex_count(0)
+{
+	glGenBuffers(1, &vertex_buffer);
+}
+
+CompactMesh::~CompactMesh()
+{
+	if (vertex_buffer != 0)
+	{
+		glstate::invalidate();
+		glDeleteBuffers(1, &vertex_buffer);
+	}
+}
+
+CompactMesh::CompactMesh(CompactMesh&& other) noexcept
+	: vertex_array(std::move(other.vertex_array))
+	, vertex_buffer(std::exchange(other.vertex_buffer, 0))
+	, index_buffer(std::move(other.index_buffer))
+	, vertex_count(std::exchange(other.vertex_count, 0))
+{
+}
+
+CompactMesh& CompactMesh::operator=(CompactMesh&& other) noexcept
+{
+	if (this != &other)
+	{
+		CompactMesh old{std::move(*this)};
+		vertex_array = std::move(other.vertex_array);
+		vertex_buffer = std::exchange(other.vertex_buffer, 0);
+		index_buffer = std::move(other.index_buffer);
+		vertex_count = std::exchange(other.vertex_count, 0);
+	}
+	return *this;
+}
+
+void CompactMesh::set(const Mesh& mesh)
+{
+	vertex_count = static_cast<unsigned int>(mesh.position.size());
+
+	if (mesh.indices.size() > 0)
+	{
+		index_buffer.set(mesh.indices);
+	}
+
+	bind();
+	upload_vertices(mesh, vertex_buffer);
+
+	// the element array binding is part of the vertex array, it must stay bound
+	const auto elements = mesh.indices.size() > 0 ? index_buffer.handle : 0;
+	glstate::bind_buffer(GL_ELEMENT_ARRAY_BUFFER, elements);
+	unbind();
+}
+
+void CompactMesh::bind()
+{
+	vertex_array.bind();
+}
+
+void CompactMesh::draw()
+{
+	if (index_buffer.count > 0)
+	{
+		glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(index_buffer.count), GL_UNSIGNED_INT, 0);
+	}
+	else
+	{
+		glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertex_count));
+	}
+	glstate::count_calls(1);
+}
+
+void CompactMesh::draw_instanced(unsigned int numInstances)
+{
+	if (index_buffer.count > 0)
+	{
+		glDrawElementsInstanced(
+			GL_TRIANGLES,
+			static_cast<GLsizei>(index_buffer.count),
+			GL_UNSIGNED_INT,
+			0,
+			static_cast<GLsizei>(numInstances)
+		);
+	}
+	else
+	{
+		glDrawArraysInstanced(
+			GL_TRIANGLES, 0, static_cast<GLsizei>(vertex_count), static_cast<GLsizei>(numInstances)
+		);
+	}
+	glstate::count_calls(1);
+}
+
+void CompactMesh::unbind()
+{
+	glstate::bind_default_vertex_array();
+}
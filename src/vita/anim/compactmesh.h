@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "vita/anim/indexbuffer.h"
+#include "vita/anim/mesh.h"
+#include "vita/anim/uniformbuffer.h"
+#include "vita/anim/vertexarray.h"
+
+/// a unit normal folded onto an octahedron and stored as two snorm16, 4 bytes instead of 12
+std::array<std::int16_t, 2> encode_octahedral_normal(const vec3& normal);
+vec3 decode_octahedral_normal(const std::array<std::int16_t, 2>& encoded);
+
+/// ieee 754 binary16, rounded to nearest even
+std::uint16_t float_to_half(float value);
+float half_to_float(std::uint16_t half);
+
+/// unorm8 weights, the rounding error goes to the largest weight so they still sum to exactly 255
+std::array<std::uint8_t, 4> encode_weights(const vec4& weights);
+
+#pragma pack(push, 1)
+
+/// one interleaved vertex, the joints index the palette buffer so they always fit in a byte
+struct CompactVertex
+{
+	vec3 position;
+	std::array<std::int16_t, 2> normal;
+	std::array<std::uint16_t, 2> texcoord;
+	std::array<std::uint8_t, 4> weights;
+	std::array<std::uint8_t, 4> joints;
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(CompactVertex) == 28, "Invalid size");
+static_assert(MAX_PALETTE_JOINTS <= 256, "Compact joints don't fit in a byte");
+
+/// fill the compact vertices from a mesh, streams the mesh lacks are left at zero
+std::vector<CompactVertex> make_compact_vertices(const Mesh& mesh);
+
+/// the attribute locations the compact shaders declare, the vertex array is set up once for them
+constexpr unsigned int COMPACT_POSITION_SLOT = 0;
+constexpr unsigned int COMPACT_NORMAL_SLOT = 1;
+constexpr unsigned int COMPACT_TEXCOORD_SLOT = 2;
+constexpr unsigned int COMPACT_WEIGHTS_SLOT = 3;
+constexpr unsigned int COMPACT_JOINTS_SLOT = 4;
+
+/// a Mesh as a single interleaved buffer of CompactVertex, 28 bytes per vertex instead of 64,
+/// with the bindings captured in a vertex array object so a draw is a single bind
+struct CompactMesh
+{
+	VertexArray vertex_array;
+	unsigned int vertex_buffer;
+	IndexBuffer index_buffer;
+	unsigned int vertex_count;
+
+	CompactMesh();
+	~CompactMesh();
+
+	CompactMesh(const CompactMesh& other) = delete;
+	void operator=(const CompactMesh& other) = delete;
+	CompactMesh(CompactMesh&& other) noexcept;
+	CompactMesh& operator=(CompactMesh&& other) noexcept;
+
+	/// the mesh may only use the first MAX_PALETTE_JOINTS joints, the palette the shader indexes
+	void set(const Mesh& mesh);
+
+	void bind();
+	void draw();
+	void draw_instanced(unsigned int numInstances);
+	/// back to the default vertex array
+	void unbind();
+};
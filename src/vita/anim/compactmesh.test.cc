@@ -0,0 +1,45 @@
+#include "catch.hpp"
+
+#include "vita/anim/compactmesh.h"
+
+#include <cmath>
+
+TEST_CASE("compact vertex encodings round trip")
+{
+	const vec3 directions[] = {
+		vec3(1.0f, 0.0f, 0.0f),
+		vec3(0.0f, -1.0f, 0.0f),
+		vec3(0.0f, 0.0f, -1.0f),
+		vec3(0.3f, -0.5f, 0.8f),
+		vec3(-0.7f, 0.2f, -0.4f),
+		vec3(0.01f, 0.02f, -1.0f),
+	};
+	for (const auto& direction: directions)
+	{
+		const auto normal = get_normalized(direction);
+		const auto decoded = decode_octahedral_normal(encode_octahedral_normal(normal));
+		CHECK(dot(normal, decoded) > 0.99999f);
+	}
+
+	for (const auto value: {0.0f, 1.0f, -2.5f, 0.5f, 65504.0f, 0.25f / 1024.0f})
+	{
+		CHECK(half_to_float(float_to_half(value)) == value);
+	}
+	CHECK(std::abs(half_to_float(float_to_half(1.0f / 3.0f)) - 1.0f / 3.0f) < 0.0002f);
+	CHECK(std::isinf(half_to_float(float_to_half(100000.0f))));
+	// halfway between 1 and the next half rounds to even
+	CHECK(float_to_half(1.0f + 1.0f / 2048.0f) == float_to_half(1.0f));
+
+	const vec4 weights[] = {
+		vec4(1.0f, 0.0f, 0.0f, 0.0f),
+		vec4(0.25f, 0.25f, 0.25f, 0.25f),
+		vec4(0.333f, 0.333f, 0.334f, 0.0f),
+		vec4(0.1f, 0.2f, 0.3f, 0.4f),
+	};
+	for (const auto& weight: weights)
+	{
+		const auto encoded = encode_weights(weight);
+		CHECK(encoded[0] + encoded[1] + encoded[2] + encoded[3] == 255);
+		CHECK(std::abs(encoded[3] / 255.0f - weight.w) < 0.005f);
+	}
+}
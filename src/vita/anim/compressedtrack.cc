@@ -0,0 +1,447 @@
+#include "vita/anim/compressedtrack.h"
+
+#include "vita/anim/tracksampling.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+constexpr float U16_MAX = 65535.0f;
+constexpr float U15_MAX = 32767.0f;
+
+/// the smallest three components of a unit quaternion are within +-1/sqrt(2)
+constexpr float SMALLEST_THREE_RANGE = 0.70710678f;
+
+namespace
+{
+u16 quantize_unit(float f, float max)
+{
+	return static_cast<u16>(std::lround(std::clamp(f, 0.0f, 1.0f) * max));
+}
+
+float dequantize_unit(u16 u, float max)
+{
+	return static_cast<float>(u) / max;
+}
+}  //  namespace
+
+CompressedKey compress_quat(const quat& q)
+{
+	auto normalized = get_normalized(q);
+
+	std::size_t largest = 0;
+	for (std::size_t component = 1; component < 4; ++component)
+	{
+		if (std::abs(normalized[component]) > std::abs(normalized[largest]))
+		{
+			largest = component;
+		}
+	}
+
+	// q and -q is the same rotation so the dropped component can always be positive
+	if (normalized[largest] < 0.0f)
+	{
+		normalized = -normalized;
+	}
+
+	u16 small[3] = {0, 0, 0};
+	std::size_t index = 0;
+	for (std::size_t component = 0; component < 4; ++component)
+	{
+		if (component == largest)
+		{
+			continue;
+		}
+		const auto unit = normalized[component] / SMALLEST_THREE_RANGE * 0.5f + 0.5f;
+		small[index] = quantize_unit(unit, U15_MAX);
+		index += 1;
+	}
+
+	// the 2 bit index of the largest component is stored in the top bits of the first two values
+	const auto high = static_cast<u16>(((largest >> 1) & 1) << 15);
+	const auto low = static_cast<u16>((largest & 1) << 15);
+	return {{static_cast<u16>(small[0] | high), static_cast<u16>(small[1] | low), small[2]}};
+}
+
+quat decompress_quat(const CompressedKey& key)
+{
+	const auto largest
+		= static_cast<std::size_t>(((key.data[0] >> 15) << 1) | (key.data[1] >> 15));
+
+	quat result;
+	float sum = 0.0f;
+	std::size_t index = 0;
+	for (std::size_t component = 0; component < 4; ++component)
+	{
+		if (component == largest)
+		{
+			continue;
+		}
+		const auto bits = static_cast<u16>(key.data[index] & 0x7FFF);
+		const auto value = (dequantize_unit(bits, U15_MAX) * 2.0f - 1.0f) * SMALLEST_THREE_RANGE;
+		result[component] = value;
+		sum += value * value;
+		index += 1;
+	}
+	result[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+
+	return result;
+}
+
+CompressedKey compress_vec3(const vec3& v, const vec3& range_min, const vec3& range_extent)
+{
+	auto value = v;
+	auto min = range_min;
+	auto extent = range_extent;
+
+	CompressedKey result = {{0, 0, 0}};
+	for (std::size_t component = 0; component < 3; ++component)
+	{
+		if (extent[component] > 0.0f)
+		{
+			const auto unit = (value[component] - min[component]) / extent[component];
+			result.data[component] = quantize_unit(unit, U16_MAX);
+		}
+	}
+	return result;
+}
+
+vec3 decompress_vec3(const CompressedKey& key, const vec3& range_min, const vec3& range_extent)
+{
+	return {
+		range_min.x + dequantize_unit(key.data[0], U16_MAX) * range_extent.x,
+		range_min.y + dequantize_unit(key.data[1], U16_MAX) * range_extent.y,
+		range_min.z + dequantize_unit(key.data[2], U16_MAX) * range_extent.z
+	};
+}
+
+namespace
+{
+/// frames with linear interpolation that reproduce a cubic track
+template<typename T>
+std::vector<Frame<T>> resample_cubic_frames(const std::vector<Frame<T>>& frames)
+{
+	const auto track = Track<T>{frames, Interpolation::Cubic};
+	if (track.is_valid() == false)
+	{
+		return frames;
+	}
+
+	const auto start_time = track.get_start_time();
+	const auto duration = track.get_end_time() - start_time;
+	const auto number_of_samples = static_cast<std::size_t>(std::ceil(
+		std::max(0.0f, duration) * static_cast<float>(COMPRESSED_CUBIC_SAMPLES_PER_SECOND)
+	)) + 1;
+
+	std::vector<Frame<T>> result;
+	result.reserve(number_of_samples);
+	for (std::size_t sample = 0; sample < number_of_samples; ++sample)
+	{
+		const auto t = number_of_samples > 1
+						 ? static_cast<float>(sample) / static_cast<float>(number_of_samples - 1)
+						 : 0.0f;
+		const auto time = start_time + t * duration;
+		result.emplace_back(time, T(), T(), track.get_sample(time, false));
+	}
+	return result;
+}
+
+void set_range(CompressedTrack<vec3>& track, const std::vector<Frame<vec3>>& frames)
+{
+	if (frames.empty())
+	{
+		return;
+	}
+
+	auto min = frames[0].value;
+	auto max = frames[0].value;
+	for (const auto& frame: frames)
+	{
+		auto value = frame.value;
+		for (std::size_t component = 0; component < 3; ++component)
+		{
+			min[component] = std::min(min[component], value[component]);
+			max[component] = std::max(max[component], value[component]);
+		}
+	}
+
+	track.range_min = min;
+	track.range_extent = max - min;
+}
+
+void set_range(CompressedTrack<quat>&, const std::vector<Frame<quat>>&)
+{
+}
+
+CompressedKey compress_value(const CompressedTrack<vec3>& track, const vec3& v)
+{
+	return compress_vec3(v, track.range_min, track.range_extent);
+}
+
+CompressedKey compress_value(const CompressedTrack<quat>&, const quat& q)
+{
+	return compress_quat(q);
+}
+
+vec3 decompress_value(const CompressedTrack<vec3>& track, const CompressedKey& key)
+{
+	return decompress_vec3(key, track.range_min, track.range_extent);
+}
+
+quat decompress_value(const CompressedTrack<quat>&, const CompressedKey& key)
+{
+	return decompress_quat(key);
+}
+
+float get_quantization_error(const CompressedTrack<vec3>& track)
+{
+	// half a step in every component, and the float rounding when decoding
+	const auto extent = std::sqrt(get_length_sq(track.range_extent));
+	const auto magnitude = std::sqrt(get_length_sq(track.range_min)) + extent;
+	return extent * 0.5f / U16_MAX + magnitude * 2.0f * std::numeric_limits<float>::epsilon();
+}
+
+float get_quantization_error(const CompressedTrack<quat>&)
+{
+	// half a step in the three stored components, the rebuilt component can be off by at most
+	// three times that since it is never smaller than 0.5, for small errors the angle is twice
+	// the length of the difference
+	const auto half_step = SMALLEST_THREE_RANGE / U15_MAX;
+	const auto stored = std::sqrt(3.0f) * half_step;
+	const auto rebuilt = 3.0f * half_step;
+	return 2.0f * std::sqrt(stored * stored + rebuilt * rebuilt);
+}
+
+float get_distance(const vec3& lhs, const vec3& rhs)
+{
+	return std::sqrt(get_length_sq(lhs - rhs));
+}
+
+float get_distance(const quat& lhs, const quat& rhs)
+{
+	return get_angle_between(lhs, rhs);
+}
+
+/// the fastest the value changes between two keys, per second
+template<typename T>
+float get_max_change_rate(const CompressedTrack<T>& track)
+{
+	float result = 0.0f;
+	for (std::size_t index = 1; index < track.times.size(); ++index)
+	{
+		const auto delta = track.get_time(index) - track.get_time(index - 1);
+		if (delta > 0.0f)
+		{
+			const auto change = get_distance(track.get_value(index - 1), track.get_value(index));
+			result = std::max(result, change / delta);
+		}
+	}
+	return result;
+}
+
+/// the quantized key time, as a float to compare against the keys
+template<typename T>
+float get_quantized_time(const CompressedTrack<T>& track, float track_time)
+{
+	return (track_time - track.start_time) / track.duration * U16_MAX;
+}
+
+/// the last key with a time less or equal to the quantized time, -1 if before the first key
+int search_compressed_key(const std::vector<u16>& times, float quantized_time)
+{
+	// also catches nan
+	if ((quantized_time >= static_cast<float>(times[0])) == false)
+	{
+		return -1;
+	}
+
+	const auto found = std::upper_bound(
+		times.begin(),
+		times.end(),
+		quantized_time,
+		[](float lhs, u16 rhs) { return lhs < static_cast<float>(rhs); }
+	);
+	return static_cast<int>(found - times.begin()) - 1;
+}
+
+/// the quantized time of a key, for the shared key searches
+auto get_key_times(const std::vector<u16>& times)
+{
+	return [&times](int index)
+	{ return static_cast<float>(times[static_cast<std::size_t>(index)]); };
+}
+
+/// the shared key guards on the quantized time, a track without a duration has nothing to search
+template<typename T, typename Search>
+int find_compressed_key(
+	const CompressedTrack<T>& track, float track_time, bool looping, Search search
+)
+{
+	if (track.duration <= 0.0f)
+	{
+		return -1;
+	}
+
+	return find_key_index(
+		static_cast<int>(track.times.size()),
+		get_quantized_time(track, track_time),
+		looping,
+		get_key_times(track.times),
+		search
+	);
+}
+
+template<typename T>
+T sample_compressed_key(const CompressedTrack<T>& track, int key_index, float track_time)
+{
+	if (key_index < 0 || key_index >= static_cast<int>(track.times.size()))
+	{
+		return T();
+	}
+	const auto this_index = static_cast<std::size_t>(key_index);
+
+	if (track.interpolation == Interpolation::Constant || this_index + 1 >= track.times.size())
+	{
+		return track.get_value(this_index);
+	}
+
+	const auto next_index = this_index + 1;
+	const auto this_time = track.get_time(this_index);
+	const auto frame_delta = track.get_time(next_index) - this_time;
+	if (frame_delta <= 0.0f)
+	{
+		// keys closer than the time precision
+		return track.get_value(next_index);
+	}
+
+	const auto t = std::clamp((track_time - this_time) / frame_delta, 0.0f, 1.0f);
+	return linear_track_helpers::interpolate(
+		track.get_value(this_index), track.get_value(next_index), t
+	);
+}
+}  //  namespace
+
+template<typename T>
+CompressedTrack<T>::CompressedTrack(const std::vector<Frame<T>>& fra, Interpolation in)
+	: start_time(0.0f)
+	, duration(0.0f)
+	, interpolation(in)
+{
+	const auto frames = in == Interpolation::Cubic ? resample_cubic_frames(fra) : fra;
+	if (in == Interpolation::Cubic)
+	{
+		interpolation = Interpolation::Linear;
+	}
+
+	if (frames.empty())
+	{
+		return;
+	}
+
+	start_time = frames[0].time;
+	duration = std::max(0.0f, frames[frames.size() - 1].time - start_time);
+	set_range(*this, frames);
+
+	times.reserve(frames.size());
+	values.reserve(frames.size());
+	for (const auto& frame: frames)
+	{
+		const auto unit = duration > 0.0f ? (frame.time - start_time) / duration : 0.0f;
+		times.emplace_back(quantize_unit(unit, U16_MAX));
+		values.emplace_back(compress_value(*this, frame.value));
+	}
+}
+
+template<typename T>
+bool CompressedTrack<T>::is_valid() const
+{
+	return times.size() > 1;
+}
+
+template<typename T>
+float CompressedTrack<T>::get_start_time() const
+{
+	return start_time;
+}
+
+template<typename T>
+float CompressedTrack<T>::get_end_time() const
+{
+	return start_time + duration;
+}
+
+template<typename T>
+T CompressedTrack<T>::get_sample(float time, bool looping) const
+{
+	const auto track_time
+		= adjust_time_to_fit_range(get_start_time(), get_end_time(), time, looping);
+	const auto index = find_compressed_key(
+		*this, track_time, looping, [this](float q) { return search_compressed_key(times, q); }
+	);
+	return sample_compressed_key(*this, index, track_time);
+}
+
+template<typename T>
+T CompressedTrack<T>::get_sample(float time, bool looping, TrackCursor& cursor) const
+{
+	const auto track_time
+		= adjust_time_to_fit_range(get_start_time(), get_end_time(), time, looping);
+	const auto index = find_compressed_key(
+		*this,
+		track_time,
+		looping,
+		[this, &cursor](float q)
+		{
+			return search_key_from_cursor(
+				static_cast<int>(times.size()),
+				q,
+				cursor.frame,
+				get_key_times(times),
+				[this](float search_time) { return search_compressed_key(times, search_time); }
+			);
+		}
+	);
+	if (index >= 0)
+	{
+		cursor.frame = index;
+	}
+	return sample_compressed_key(*this, index, track_time);
+}
+
+template<typename T>
+float CompressedTrack<T>::get_time(std::size_t index) const
+{
+	return start_time + dequantize_unit(times[index], U16_MAX) * duration;
+}
+
+template<typename T>
+T CompressedTrack<T>::get_value(std::size_t index) const
+{
+	return decompress_value(*this, values[index]);
+}
+
+template<typename T>
+float CompressedTrack<T>::get_error_bound() const
+{
+	// both keys around a sample can move half a time step
+	const auto time_error = duration / U16_MAX;
+	return get_quantization_error(*this) + get_max_change_rate(*this) * time_error;
+}
+
+template<typename T>
+std::size_t CompressedTrack<T>::get_memory_usage() const
+{
+	return times.size() * sizeof(u16) + values.size() * sizeof(CompressedKey);
+}
+
+template<typename T>
+CompressedTrack<T> compress_track(const Track<T>& track)
+{
+	return CompressedTrack<T>{track.frames, track.interpolation};
+}
+
+template struct CompressedTrack<vec3>;
+template struct CompressedTrack<quat>;
+
+template CompressedTrack<vec3> compress_track(const Track<vec3>& track);
+template CompressedTrack<quat> compress_track(const Track<quat>& track);
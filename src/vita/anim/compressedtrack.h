@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+
+#include "vita/anim/track.h"
+
+/// cubic tracks are resampled to linear keys at this rate when compressed
+constexpr unsigned int COMPRESSED_CUBIC_SAMPLES_PER_SECOND = 60;
+
+/// 48 bits, either a range quantized vec3 or a smallest three quaternion
+struct CompressedKey
+{
+	u16 data[3];
+};
+
+/// the largest component is dropped and rebuilt from the other three stored in 15 bits each
+CompressedKey compress_quat(const quat& q);
+quat decompress_quat(const CompressedKey& key);
+
+/// each component is stored in 16 bits relative to the range
+CompressedKey compress_vec3(const vec3& v, const vec3& range_min, const vec3& range_extent);
+vec3 decompress_vec3(const CompressedKey& key, const vec3& range_min, const vec3& range_extent);
+
+/// a track with the key times stored in 16 bits over the duration and the values in 48 bits,
+/// sampling only decodes the two keys around the time
+template<typename T>
+struct CompressedTrack
+{
+	std::vector<u16> times;
+	std::vector<CompressedKey> values;
+
+	float start_time;
+	float duration;
+
+	/// the range vector values are quantized within, not used by quaternion tracks
+	vec3 range_min;
+	vec3 range_extent;
+
+	/// cubic tracks are resampled so this is either constant or linear
+	Interpolation interpolation;
+
+	CompressedTrack(const std::vector<Frame<T>>& fra, Interpolation in);
+
+	bool is_valid() const;
+
+	float get_start_time() const;
+	float get_end_time() const;
+	T get_sample(float time, bool looping) const;
+	T get_sample(float time, bool looping, TrackCursor& cursor) const;
+
+	/// decode a single key
+	float get_time(std::size_t index) const;
+	T get_value(std::size_t index) const;
+
+	/// the largest error the quantization can introduce, in units for vector tracks and radians
+	/// for quaternion tracks
+	float get_error_bound() const;
+
+	/// the bytes used by the keys
+	std::size_t get_memory_usage() const;
+};
+
+typedef CompressedTrack<vec3> CompressedVectorTrack;
+typedef CompressedTrack<quat> CompressedQuaternionTrack;
+
+template<typename T>
+CompressedTrack<T> compress_track(const Track<T>& track);
@@ -0,0 +1,86 @@
+#include "vita/bench.h"
+
+#include "vita/assets.h"
+#include "vita/anim/crowd.h"
+#include "vita/anim/gltfloader.h"
+
+#include <iostream>
+
+namespace
+{
+/// a made up mesh since Mesh needs a GL context, roughly the size of woman.gltf
+SoaSkinMesh make_crowd_mesh(std::size_t number_of_vertices, std::size_t number_of_joints)
+{
+	std::vector<vec3> position;
+	std::vector<vec3> normal;
+	std::vector<vec4> weights;
+	std::vector<ivec4> influences;
+	for (std::size_t index = 0; index < number_of_vertices; ++index)
+	{
+		const auto f = static_cast<float>(index);
+		const auto joint = [index, number_of_joints](std::size_t offset)
+		{
+			return static_cast<int>((index + offset * 7) % number_of_joints);
+		};
+		position.emplace_back(f * 0.01f, f * 0.02f, f * -0.01f);
+		normal.emplace_back(0.0f, 1.0f, 0.0f);
+		weights.emplace_back(0.4f, 0.3f, 0.2f, 0.1f);
+		influences.emplace_back(joint(0), joint(1), joint(2), joint(3));
+	}
+	return make_soa_skin_mesh(position, normal, weights, influences);
+}
+}  //  namespace
+
+BENCHMARK("crowd update woman.gltf")
+{
+	constexpr std::size_t NUMBER_OF_CHARACTERS = 200;
+	constexpr std::size_t NUMBER_OF_VERTICES = 3000;
+
+	cgltf_data* gltf = load_gltf_file(assets::woman_gltf());
+	auto skeleton = LoadSkeleton(gltf);
+	auto clips = get_animation_clips(gltf);
+	free_gltf_file(gltf);
+
+	const auto order = sort_joints_parent_before_child(skeleton);
+	for (auto& clip: clips)
+	{
+		remap_joints(clip, order);
+	}
+
+	const auto mesh = make_crowd_mesh(NUMBER_OF_VERTICES, skeleton.rest_pose.size());
+
+	std::vector<CrowdCharacter> characters(NUMBER_OF_CHARACTERS);
+	for (std::size_t index = 0; index < characters.size(); ++index)
+	{
+		characters[index].clip = index % clips.size();
+		characters[index].time = static_cast<float>(index) * 0.0371f;
+		characters[index].pose = skeleton.rest_pose;
+	}
+
+	const auto hardware_threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+	std::cout << hardware_threads << " hardware threads\n";
+
+	double single = 0.0;
+	for (std::size_t threads = 1; threads <= hardware_threads; ++threads)
+	{
+		auto job_system = jobs::JobSystem{threads - 1};
+		const auto name = std::to_string(threads) + " threads";
+		const auto measured = bench::measure(
+			name,
+			[&]()
+			{
+				update_crowd(job_system, characters, clips, skeleton, mesh, 1.0f / 60.0f);
+				bench::use(characters[0].skinned_position[0].x);
+			}
+		);
+
+		if (threads == 1)
+		{
+			single = measured;
+		}
+		else
+		{
+			bench::print_speedup(name, single, measured);
+		}
+	}
+}
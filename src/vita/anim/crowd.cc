@@ -0,0 +1,83 @@
+#include "vita/anim/crowd.h"
+
+#include "vita/assert.h"
+
+namespace
+{
+void update_palette(
+	CrowdCharacter& character,
+	const std::vector<Clip>& clips,
+	const Skeleton& skeleton,
+	float delta_time
+)
+{
+	ASSERT(character.clip < clips.size());
+
+	character.time
+		= clips[character.clip].sample_to_pose(character.pose, character.time + delta_time);
+	calc_matrix_palette(character.pose, character.local_transforms, character.pose_palette);
+	calc_skin_palette(character.pose_palette, skeleton.inverse_bind_pose, character.skin_palette);
+}
+}  //  namespace
+
+void update_crowd(
+	jobs::JobSystem& job_system,
+	std::vector<CrowdCharacter>& characters,
+	const std::vector<Clip>& clips,
+	const Skeleton& skeleton,
+	const SoaSkinMesh& mesh,
+	float delta_time
+)
+{
+	job_system.parallel_for(
+		characters.size(),
+		1,
+		[&](std::size_t begin, std::size_t end)
+		{
+			for (auto index = begin; index < end; ++index)
+			{
+				auto& character = characters[index];
+				update_palette(character, clips, skeleton, delta_time);
+				soa_skin::skin_vertices(
+					mesh,
+					character.skin_palette,
+					character.skinned_position,
+					character.skinned_normal
+				);
+			}
+		}
+	);
+}
+
+void update_crowd_palettes(
+	jobs::JobSystem& job_system,
+	std::vector<CrowdCharacter>& characters,
+	const std::vector<Clip>& clips,
+	const Skeleton& skeleton,
+	float delta_time
+)
+{
+	// a palette is much cheaper than skinning, give each task a few characters
+	job_system.parallel_for(
+		characters.size(),
+		16,
+		[&](std::size_t begin, std::size_t end)
+		{
+			for (auto index = begin; index < end; ++index)
+			{
+				update_palette(characters[index], clips, skeleton, delta_time);
+			}
+		}
+	);
+}
+
+void advance_crowd_time(
+	std::vector<CrowdCharacter>& characters, const std::vector<Clip>& clips, float delta_time
+)
+{
+	for (auto& character: characters)
+	{
+		ASSERT(character.clip < clips.size());
+		character.time = clips[character.clip].adjust_time_to_fit(character.time + delta_time);
+	}
+}
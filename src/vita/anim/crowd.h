@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+
+#include "vita/jobs.h"
+#include "vita/anim/clip.h"
+#include "vita/anim/mesh.h"
+#include "vita/anim/pose.h"
+#include "vita/anim/skeleton.h"
+#include "vita/anim/soaskin.h"
+#include "vita/anim/soatransform.h"
+
+struct CrowdCharacter
+{
+	std::size_t clip = 0;
+	float time = 0.0f;
+	Transform model;
+
+	Pose pose;
+	SoaTransforms local_transforms;
+	std::vector<mat4> pose_palette;
+	std::vector<mat4> skin_palette;
+	std::vector<vec3> skinned_position;
+	std::vector<vec3> skinned_normal;
+};
+
+/// advance, sample, build the palette and skin every character, each character is a separate task
+/// and only writes to itself so the result is the same for any number of threads
+void update_crowd(
+	jobs::JobSystem& job_system,
+	std::vector<CrowdCharacter>& characters,
+	const std::vector<Clip>& clips,
+	const Skeleton& skeleton,
+	const SoaSkinMesh& mesh,
+	float delta_time
+);
+
+/// only advance the time, for crowds playing baked animations on the GPU
+void advance_crowd_time(
+	std::vector<CrowdCharacter>& characters, const std::vector<Clip>& clips, float delta_time
+);
+
+/// update_crowd without the skinning, for crowds skinned on the GPU
+void update_crowd_palettes(
+	jobs::JobSystem& job_system,
+	std::vector<CrowdCharacter>& characters,
+	const std::vector<Clip>& clips,
+	const Skeleton& skeleton,
+	float delta_time
+);
@@ -0,0 +1,152 @@
+#include "vita/anim/crowdrenderer.h"
+
+#include "vita/assert.h"
+#include "vita/anim/uniform.h"
+
+namespace
+{
+/// bind the shared vertices and the per instance attributes and draw every mesh once, the
+/// instance attributes are bound after the mesh so they end up in its vertex array
+void draw_instances(
+	Shader& shader,
+	std::vector<Mesh>& meshes,
+	Attribute<mat4>& models,
+	Attribute<vec3>* instances,
+	unsigned int count
+)
+{
+	const auto position = static_cast<int>(shader.get_attribute("position"));
+	const auto normal = static_cast<int>(shader.get_attribute("normal"));
+	const auto texcoord = static_cast<int>(shader.get_attribute("texCoord"));
+	const auto weights = static_cast<int>(shader.get_attribute("weights"));
+	const auto joints = static_cast<int>(shader.get_attribute("joints"));
+	const auto model = shader.get_attribute("model");
+	const auto instance = instances != nullptr ? shader.get_attribute("instance") : 0;
+
+	for (auto& mesh: meshes)
+	{
+		mesh.Bind(position, normal, texcoord, weights, joints);
+		models.bind_to_instanced(model);
+		if (instances != nullptr)
+		{
+			instances->bind_to_instanced(instance);
+		}
+
+		mesh.DrawInstanced(count);
+
+		if (instances != nullptr)
+		{
+			instances->unbind_from(instance);
+		}
+		models.unbind_from(model);
+		mesh.UnBind(position, normal, texcoord, weights, joints);
+	}
+}
+}  //  namespace
+
+CrowdRenderer::CrowdRenderer(const ShaderSource& vertex, const ShaderSource& fragment)
+	: shader(vertex, fragment)
+{
+}
+
+void CrowdRenderer::set_instances(const std::vector<CrowdCharacter>& characters)
+{
+	number_of_joints = characters.empty() ? 0 : characters[0].skin_palette.size();
+
+	palette_data.resize(characters.size() * number_of_joints);
+	model_data.resize(characters.size());
+	for (std::size_t index = 0; index < characters.size(); ++index)
+	{
+		const auto& character = characters[index];
+		ASSERT(character.skin_palette.size() == number_of_joints);
+		std::copy(
+			character.skin_palette.begin(),
+			character.skin_palette.end(),
+			palette_data.begin() + static_cast<std::ptrdiff_t>(index * number_of_joints)
+		);
+		model_data[index] = mat4_from_transform(character.model);
+	}
+
+	if (model_data.empty() == false)
+	{
+		palettes.set(palette_data);
+		models.set(model_data);
+	}
+}
+
+void CrowdRenderer::draw(
+	std::vector<Mesh>& meshes, Texture& diffuse, const mat4& view, const mat4& projection
+)
+{
+	if (model_data.empty())
+	{
+		return;
+	}
+
+	shader.bind();
+	Uniform<mat4>::Set(shader.get_uniform("view"), view);
+	Uniform<mat4>::Set(shader.get_uniform("projection"), projection);
+	Uniform<vec3>::Set(shader.get_uniform("light"), vec3(1, 1, 1));
+	Uniform<int>::Set(shader.get_uniform("numberOfJoints"), static_cast<int>(number_of_joints));
+	palettes.bind(shader.get_uniform("palettes"), 1);
+	diffuse.bind(shader.get_uniform("tex0"), 0);
+
+	draw_instances(shader, meshes, models, nullptr, static_cast<unsigned int>(model_data.size()));
+
+	diffuse.unbind(0);
+	palettes.unbind(1);
+	shader.unbind();
+}
+
+BakedCrowdRenderer::BakedCrowdRenderer(
+	const ShaderSource& vertex, const ShaderSource& fragment, const BakedAnimation& animation
+)
+	: shader(vertex, fragment)
+	, palettes(animation.get_texture_data())
+	, baked(animation)
+{
+	baked.texels.clear();
+	baked.texels.shrink_to_fit();
+}
+
+void BakedCrowdRenderer::set_instances(const std::vector<CrowdCharacter>& characters)
+{
+	model_data.resize(characters.size());
+	instance_data.resize(characters.size());
+	for (std::size_t index = 0; index < characters.size(); ++index)
+	{
+		const auto& character = characters[index];
+		model_data[index] = mat4_from_transform(character.model);
+		instance_data[index] = baked.get_instance(character.clip, character.time);
+	}
+
+	if (model_data.empty() == false)
+	{
+		models.set(model_data);
+		instances.set(instance_data);
+	}
+}
+
+void BakedCrowdRenderer::draw(
+	std::vector<Mesh>& meshes, Texture& diffuse, const mat4& view, const mat4& projection
+)
+{
+	if (model_data.empty())
+	{
+		return;
+	}
+
+	shader.bind();
+	Uniform<mat4>::Set(shader.get_uniform("view"), view);
+	Uniform<mat4>::Set(shader.get_uniform("projection"), projection);
+	Uniform<vec3>::Set(shader.get_uniform("light"), vec3(1, 1, 1));
+	palettes.bind(shader.get_uniform("palettes"), 1);
+	diffuse.bind(shader.get_uniform("tex0"), 0);
+
+	const auto count = static_cast<unsigned int>(model_data.size());
+	draw_instances(shader, meshes, models, &instances, count);
+
+	diffuse.unbind(0);
+	palettes.unbind(1);
+	shader.unbind();
+}
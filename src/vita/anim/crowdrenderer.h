@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+
+#include "vita/anim/attribute.h"
+#include "vita/anim/bakedanimation.h"
+#include "vita/anim/crowd.h"
+#include "vita/anim/mesh.h"
+#include "vita/anim/shader.h"
+#include "vita/anim/texture.h"
+#include "vita/anim/texturebuffer.h"
+
+/// draws all characters of a crowd with one instanced draw per mesh, the shader reads the palette
+/// of each instance from a texture buffer using gl_InstanceID and the model matrix from an
+/// instanced attribute
+struct CrowdRenderer
+{
+	Shader shader;
+	TextureBuffer palettes;
+	Attribute<mat4> models;
+
+	std::vector<mat4> palette_data;
+	std::vector<mat4> model_data;
+	std::size_t number_of_joints = 0;
+
+	CrowdRenderer(const ShaderSource& vertex, const ShaderSource& fragment);
+
+	/// gather the skin palettes and models of every character and upload them, once per frame
+	void set_instances(const std::vector<CrowdCharacter>& characters);
+
+	void draw(
+		std::vector<Mesh>& meshes, Texture& diffuse, const mat4& view, const mat4& projection
+	);
+};
+
+/// CrowdRenderer for characters playing baked clips, the shader interpolates the palette from the
+/// baked texture so the only per character work on the cpu is advancing the time
+struct BakedCrowdRenderer
+{
+	Shader shader;
+	Texture palettes;
+	Attribute<mat4> models;
+	Attribute<vec3> instances;
+
+	/// the clip ranges, the texels are only kept on the gpu
+	BakedAnimation baked;
+
+	std::vector<mat4> model_data;
+	std::vector<vec3> instance_data;
+
+	BakedCrowdRenderer(
+		const ShaderSource& vertex, const ShaderSource& fragment, const BakedAnimation& animation
+	);
+
+	/// gather the clip, time and model of every character, the palettes are ignored
+	void set_instances(const std::vector<CrowdCharacter>& characters);
+
+	void draw(
+		std::vector<Mesh>& meshes, Texture& diffuse, const mat4& view, const mat4& projection
+	);
+};
@@ -90,7 +90,8 @@ void DebugDraw::FromPose(const Pose& pose)
 		requiredVerts += 2;
 	}
 
-	mPoints.resize(requiredVerts);
+	mPoints.clear();
+	mPoints.reserve(requiredVerts);
 	for (std::size_t i = 0; i < numJoints; ++i)
 	{
 		const auto parent = pose[i].parent;
@@ -1,5 +1,7 @@
 #include "vita/anim/draw.h"
 
+#include "vita/glstate.h"
+
 #include <iostream>
 
 static GLenum C(DrawMode input)
@@ -20,23 +22,26 @@ static GLenum C(DrawMode input)
 void draw(unsigned int vertexCount, DrawMode mode)
 {
 	glDrawArrays(C(mode), 0, vertexCount);
+	glstate::count_calls(1);
 }
 
 void draw_instanced(unsigned int vertexCount, DrawMode mode, unsigned int numInstances)
 {
 	glDrawArraysInstanced(C(mode), 0, vertexCount, numInstances);
+	glstate::count_calls(1);
 }
 
 void draw(IndexBuffer& inIndexBuffer, DrawMode mode)
 {
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, inIndexBuffer.handle);
+	// stays bound in the vertex array, the next draw of the same mesh skips the bind
+	glstate::bind_buffer(GL_ELEMENT_ARRAY_BUFFER, inIndexBuffer.handle);
 	glDrawElements(C(mode), inIndexBuffer.count, GL_UNSIGNED_INT, 0);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	glstate::count_calls(1);
 }
 
 void draw_instanced(IndexBuffer& inIndexBuffer, DrawMode mode, unsigned int instanceCount)
 {
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, inIndexBuffer.handle);
+	glstate::bind_buffer(GL_ELEMENT_ARRAY_BUFFER, inIndexBuffer.handle);
 	glDrawElementsInstanced(C(mode), inIndexBuffer.count, GL_UNSIGNED_INT, 0, instanceCount);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	glstate::count_calls(1);
 }
@@ -0,0 +1,100 @@
+#include "vita/anim/dualquaternion.h"
+
+#include <cmath>
+
+DualQuaternion::DualQuaternion()
+	: real(0, 0, 0, 1)
+	, dual(0, 0, 0, 0)
+{
+}
+
+DualQuaternion::DualQuaternion(const quat& r, const quat& d)
+	: real(r)
+	, dual(d)
+{
+}
+
+const float* DualQuaternion::data_ptr() const
+{
+	return real.data_ptr();
+}
+
+DualQuaternion operator+(const DualQuaternion& l, const DualQuaternion& r)
+{
+	return DualQuaternion(l.real + r.real, l.dual + r.dual);
+}
+
+DualQuaternion operator*(const DualQuaternion& dq, float f)
+{
+	return DualQuaternion(dq.real * f, dq.dual * f);
+}
+
+DualQuaternion operator*(const DualQuaternion& l, const DualQuaternion& r)
+{
+	const auto lhs = get_normalized(l);
+	const auto rhs = get_normalized(r);
+	return DualQuaternion(lhs.real * rhs.real, lhs.real * rhs.dual + lhs.dual * rhs.real);
+}
+
+bool operator==(const DualQuaternion& l, const DualQuaternion& r)
+{
+	return l.real == r.real && l.dual == r.dual;
+}
+
+bool operator!=(const DualQuaternion& l, const DualQuaternion& r)
+{
+	return !(l == r);
+}
+
+float dot(const DualQuaternion& l, const DualQuaternion& r)
+{
+	return dot(l.real, r.real);
+}
+
+DualQuaternion get_conjugate(const DualQuaternion& dq)
+{
+	return DualQuaternion(get_conjugate(dq.real), get_conjugate(dq.dual));
+}
+
+DualQuaternion get_normalized(const DualQuaternion& dq)
+{
+	const auto length_sq = dot(dq.real, dq.real);
+	if (length_sq < QUAT_EPSILON)
+	{
+		return dq;
+	}
+	return dq * (1.0f / std::sqrt(length_sq));
+}
+
+void normalize(DualQuaternion& dq)
+{
+	dq = get_normalized(dq);
+}
+
+DualQuaternion dual_quaternion_from_transform(const Transform& t)
+{
+	const auto d = quat(t.position.x, t.position.y, t.position.z, 0);
+	const auto real = t.rotation;
+	return DualQuaternion(real, real * d * 0.5f);
+}
+
+Transform transform_from_dual_quaternion(const DualQuaternion& dq)
+{
+	const auto d = get_conjugate(dq.real) * (dq.dual * 2.0f);
+
+	Transform result;
+	result.rotation = dq.real;
+	result.position = vec3(d.x, d.y, d.z);
+	return result;
+}
+
+vec3 get_transformed_point(const DualQuaternion& dq, const vec3& v)
+{
+	const auto d = get_conjugate(dq.real) * (dq.dual * 2.0f);
+	return dq.real * v + vec3(d.x, d.y, d.z);
+}
+
+vec3 get_transformed_vector(const DualQuaternion& dq, const vec3& v)
+{
+	return dq.real * v;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "vita/anim/quat.h"
+#include "vita/anim/transform.h"
+
+#pragma pack(push, 1)
+
+/// a rotation and a translation in 8 floats, blends without the volume loss of blended matrices
+/// but can't represent scale
+struct DualQuaternion
+{
+	quat real;
+	quat dual;
+
+	DualQuaternion();
+	DualQuaternion(const quat& r, const quat& d);
+
+	const float* data_ptr() const;
+};
+
+#pragma pack(pop)
+static_assert(sizeof(DualQuaternion) == sizeof(float) * 8, "Invalid size");
+
+DualQuaternion operator+(const DualQuaternion& l, const DualQuaternion& r);
+DualQuaternion operator*(const DualQuaternion& dq, float f);
+
+/// like quat the left side is applied first, l * r is l followed by r
+DualQuaternion operator*(const DualQuaternion& l, const DualQuaternion& r);
+
+bool operator==(const DualQuaternion& l, const DualQuaternion& r);
+bool operator!=(const DualQuaternion& l, const DualQuaternion& r);
+
+float dot(const DualQuaternion& l, const DualQuaternion& r);
+
+/// the inverse of a normalized dual quaternion
+DualQuaternion get_conjugate(const DualQuaternion& dq);
+DualQuaternion get_normalized(const DualQuaternion& dq);
+void normalize(DualQuaternion& dq);
+
+/// the scale of the transform is ignored
+DualQuaternion dual_quaternion_from_transform(const Transform& t);
+Transform transform_from_dual_quaternion(const DualQuaternion& dq);
+
+vec3 get_transformed_point(const DualQuaternion& dq, const vec3& v);
+vec3 get_transformed_vector(const DualQuaternion& dq, const vec3& v);
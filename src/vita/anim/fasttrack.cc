@@ -0,0 +1,134 @@
+#include "vita/anim/fasttrack.h"
+
+#include "vita/anim/tracksampling.h"
+
+#include <algorithm>
+#include <cmath>
+
+template<typename T>
+FastTrack<T>::FastTrack(const std::vector<Frame<T>>& fra, Interpolation in)
+	: track(fra, in)
+{
+	build_index_lookup_table();
+}
+
+template<typename T>
+const std::vector<Frame<T>>& FastTrack<T>::get_frames() const
+{
+	return track.frames;
+}
+
+template<typename T>
+Interpolation FastTrack<T>::get_interpolation() const
+{
+	return track.interpolation;
+}
+
+template<typename T>
+bool FastTrack<T>::is_valid() const
+{
+	return track.is_valid();
+}
+
+template<typename T>
+float FastTrack<T>::get_start_time() const
+{
+	return track.get_start_time();
+}
+
+template<typename T>
+float FastTrack<T>::get_end_time() const
+{
+	return track.get_end_time();
+}
+
+template<typename T>
+void FastTrack<T>::build_index_lookup_table()
+{
+	sampled_frames.clear();
+	if (track.is_valid() == false)
+	{
+		return;
+	}
+
+	// sized from the keys and not the duration so a long gap between two keys stays cheap
+	const auto duration = std::max(0.0f, get_end_time() - get_start_time());
+	const auto number_of_samples = track.frames.size() * FAST_TRACK_SAMPLES_PER_KEY;
+
+	sampled_frames.resize(number_of_samples);
+	for (std::size_t sample = 0; sample < number_of_samples; ++sample)
+	{
+		const auto t = static_cast<float>(sample) / static_cast<float>(number_of_samples - 1);
+		const auto time = get_start_time() + t * duration;
+		const auto frame = track.get_frame_index(time, false);
+		sampled_frames[sample] = static_cast<unsigned int>(std::max(0, frame));
+	}
+}
+
+template<typename T>
+int FastTrack<T>::find_frame_index(float track_time, bool looping) const
+{
+	const auto& frames = track.frames;
+	const auto start_time = get_start_time();
+	const auto duration = get_end_time() - start_time;
+
+	// the track handles the ends in constant time, also catches nan
+	const auto is_inside = track_time > start_time
+						&& (looping || track_time < frames[frames.size() - 2].time);
+	if (sampled_frames.empty() || duration <= 0.0f || is_inside == false)
+	{
+		return track.get_frame_index(track_time, looping);
+	}
+
+	const auto last_sample = sampled_frames.size() - 1;
+	const auto sample = std::min(
+		last_sample,
+		static_cast<std::size_t>(
+			(track_time - start_time) / duration * static_cast<float>(last_sample)
+		)
+	);
+
+	// the lookup is only exact at the sample points, step forward over keys closer than a sample
+	// like a cursor, which falls back to the search when the keys are too dense for the table
+	return search_key_from_cursor(
+		static_cast<int>(frames.size()),
+		track_time,
+		static_cast<int>(sampled_frames[sample]),
+		[&frames](int index) { return frames[static_cast<std::size_t>(index)].time; },
+		[this, looping](float t) { return track.get_frame_index(t, looping); }
+	);
+}
+
+template<typename T>
+T FastTrack<T>::get_sample(float time, bool looping) const
+{
+	const auto track_time = track.adjust_time_to_fit(time, looping);
+	return track.get_sample_at_frame(find_frame_index(track_time, looping), track_time);
+}
+
+template<typename T>
+T FastTrack<T>::get_sample(float time, bool looping, TrackCursor& cursor) const
+{
+	// the lookup table is already constant time, the cursor is only kept up to date
+	const auto track_time = track.adjust_time_to_fit(time, looping);
+	const auto index = find_frame_index(track_time, looping);
+	if (index >= 0)
+	{
+		cursor.frame = index;
+	}
+	return track.get_sample_at_frame(index, track_time);
+}
+
+template<typename T>
+FastTrack<T> optimize_track(const Track<T>& track)
+{
+	return FastTrack<T>{track.frames, track.interpolation};
+}
+
+template struct FastTrack<float>;
+template struct FastTrack<vec3>;
+template struct FastTrack<quat>;
+
+template FastTrack<float> optimize_track(const Track<float>& track);
+template FastTrack<vec3> optimize_track(const Track<vec3>& track);
+template FastTrack<quat> optimize_track(const Track<quat>& track);
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+
+#include "vita/anim/track.h"
+
+/// lookup samples per key, with evenly spaced keys every sample is at most one key from the answer
+constexpr std::size_t FAST_TRACK_SAMPLES_PER_KEY = 2;
+
+/// a track with a precomputed lookup table from time to frame index so sampling rarely searches.
+/// The table is built from the frames once, so they can't be changed afterwards
+template<typename T>
+struct FastTrack
+{
+   public:
+
+	FastTrack(const std::vector<Frame<T>>& fra, Interpolation in);
+
+	const std::vector<Frame<T>>& get_frames() const;
+	Interpolation get_interpolation() const;
+
+	bool is_valid() const;
+
+	float get_start_time() const;
+	float get_end_time() const;
+	T get_sample(float time, bool looping) const;
+	T get_sample(float time, bool looping, TrackCursor& cursor) const;
+
+   private:
+
+	Track<T> track;
+
+	/// frame index for each uniformly spaced sample over the duration of the track
+	std::vector<unsigned int> sampled_frames;
+
+	void build_index_lookup_table();
+
+	/// the same result as Track<T>::get_frame_index but starting at the frame in the table
+	int find_frame_index(float track_time, bool looping) const;
+};
+
+typedef FastTrack<float> FastScalarTrack;
+typedef FastTrack<vec3> FastVectorTrack;
+typedef FastTrack<quat> FastQuaternionTrack;
+
+template<typename T>
+FastTrack<T> optimize_track(const Track<T>& track);
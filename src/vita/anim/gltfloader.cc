@@ -129,6 +129,70 @@ Track<T> track_from_channel(const cgltf_animation_channel& inChannel)
 	return ret;
 }
 
+/// same as track_from_channel but reads the keys straight into the separate arrays
+template<typename T, std::size_t N>
+PackedTrack<T> packed_track_from_channel(const cgltf_animation_channel& inChannel)
+{
+	cgltf_animation_sampler& sampler = *inChannel.sampler;
+
+	const auto valueFloats = scalar_values_from_accessor(N, *sampler.output);
+
+	const auto numFrames = sampler.input->count;
+	const auto numberOfValuesPerFrame = valueFloats.size() / numFrames;
+
+	const auto interpolation = interpolation_from_gltf(sampler.interpolation);
+	const auto isSamplerCubic = interpolation == Interpolation::Cubic;
+
+	PackedTrack<T> ret{{}, interpolation};
+	ret.resize(numFrames);
+
+	for (cgltf_size i = 0; i < numFrames; ++i)
+	{
+		cgltf_accessor_read_float(sampler.input, i, &ret.times[i], 1);
+	}
+
+	for (std::size_t i = 0; i < numFrames; ++i)
+	{
+		const auto baseIndex = i * numberOfValuesPerFrame;
+		std::size_t offset = 0;
+
+		if (isSamplerCubic)
+		{
+			for (std::size_t component = 0; component < N; ++component)
+			{
+				ret.in_tangents[i][component] = valueFloats[baseIndex + offset++];
+			}
+		}
+
+		for (std::size_t component = 0; component < N; ++component)
+		{
+			ret.values[i][component] = valueFloats[baseIndex + offset++];
+		}
+
+		if (isSamplerCubic)
+		{
+			for (std::size_t component = 0; component < N; ++component)
+			{
+				ret.out_tangents[i][component] = valueFloats[baseIndex + offset++];
+			}
+		}
+	}
+
+	return ret;
+}
+
+template<typename T, std::size_t N>
+void load_track(Track<T>& outTrack, const cgltf_animation_channel& channel)
+{
+	outTrack = track_from_channel<T, N>(channel);
+}
+
+template<typename T, std::size_t N>
+void load_track(PackedTrack<T>& outTrack, const cgltf_animation_channel& channel)
+{
+	outTrack = packed_track_from_channel<T, N>(channel);
+}
+
 void MeshFromAttribute(
 	Mesh& outMesh,
 	cgltf_attribute& attribute,
@@ -299,12 +363,13 @@ std::vector<std::string> get_joint_names(cgltf_data* data)
 	return result;
 }
 
-std::vector<Clip> get_animation_clips(cgltf_data* data)
+template<typename CLIP>
+std::vector<CLIP> animation_clips_from_gltf(cgltf_data* data)
 {
 	const auto numClips = data->animations_count;
 	const auto numNodes = data->nodes_count;
 
-	std::vector<Clip> result;
+	std::vector<CLIP> result;
 	result.resize(numClips);
 
 	for (std::size_t i = 0; i < numClips; ++i)
@@ -329,15 +394,15 @@ std::vector<Clip> get_animation_clips(cgltf_data* data)
 
 			if (channel.target_path == cgltf_animation_path_type_translation)
 			{
-				track.position = gltf_helpers::track_from_channel<vec3, 3>(channel);
+				gltf_helpers::load_track<vec3, 3>(track.position, channel);
 			}
 			else if (channel.target_path == cgltf_animation_path_type_scale)
 			{
-				track.scale = gltf_helpers::track_from_channel<vec3, 3>(channel);
+				gltf_helpers::load_track<vec3, 3>(track.scale, channel);
 			}
 			else if (channel.target_path == cgltf_animation_path_type_rotation)
 			{
-				track.rotation = gltf_helpers::track_from_channel<quat, 4>(channel);
+				gltf_helpers::load_track<quat, 4>(track.rotation, channel);
 			}
 		}
 		clip.duration = duration_from_tracks(clip.tracks);
@@ -346,6 +411,16 @@ std::vector<Clip> get_animation_clips(cgltf_data* data)
 	return result;
 }
 
+std::vector<Clip> get_animation_clips(cgltf_data* data)
+{
+	return animation_clips_from_gltf<Clip>(data);
+}
+
+std::vector<PackedClip> get_packed_animation_clips(cgltf_data* data)
+{
+	return animation_clips_from_gltf<PackedClip>(data);
+}
+
 Pose LoadBindPose(cgltf_data* data)
 {
 	Pose restPose = get_rest_pose(data);
@@ -424,8 +499,8 @@ std::vector<Mesh> LoadMeshes(cgltf_data* data)
 		const auto numPrims = node->mesh->primitives_count;
 		for (std::size_t j = 0; j < numPrims; ++j)
 		{
-			result.push_back(Mesh());
-			Mesh& mesh = result[result.size() - 1];
+			// Mesh moves, so growing the vector doesn't upload the meshes already loaded again
+			Mesh& mesh = result.emplace_back();
 
 			cgltf_primitive* primitive = &node->mesh->primitives[j];
 
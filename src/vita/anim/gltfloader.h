@@ -24,6 +24,7 @@ void free_gltf_file(cgltf_data* handle);
 Pose get_rest_pose(cgltf_data* data);
 std::vector<std::string> get_joint_names(cgltf_data* data);
 std::vector<Clip> get_animation_clips(cgltf_data* data);
+std::vector<PackedClip> get_packed_animation_clips(cgltf_data* data);
 
 Pose LoadBindPose(cgltf_data* data);
 Skeleton LoadSkeleton(cgltf_data* data);
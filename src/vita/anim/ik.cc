@@ -13,15 +13,30 @@ Transform GetGlobalTransform(const std::vector<Transform>& mIKChain, unsigned in
 std::vector<vec3> GetGlobalTransforms(const std::vector<Transform>& mIKChain)
 {
 	std::vector<vec3> ret;
+	GetGlobalTransforms(mIKChain, ret);
+	return ret;
+}
+
+void GetGlobalTransforms(const std::vector<Transform>& mIKChain, std::vector<vec3>& positions)
+{
 	const auto size = mIKChain.size();
-	ret.resize(size);
+	positions.resize(size);
 
 	for (std::size_t i = 0; i < size; ++i)
 	{
-		ret[i] = GetGlobalTransform(mIKChain, static_cast<unsigned int>(i)).position;
+		positions[i] = GetGlobalTransform(mIKChain, static_cast<unsigned int>(i)).position;
 	}
+}
 
-	return ret;
+void GetGlobalTransforms(const std::vector<Transform>& mIKChain, std::vector<Transform>& world)
+{
+	const auto size = mIKChain.size();
+	world.resize(size);
+
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		world[i] = i == 0 ? mIKChain[0] : get_combined(world[i - 1], mIKChain[i]);
+	}
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -30,7 +45,8 @@ bool ik_ccd(
 	std::vector<Transform>& mIKChain,
 	const Transform& target,
 	unsigned int mNumSteps,
-	float mThreshold
+	float mThreshold,
+	IkScratch& scratch
 )
 {
 	const auto size = static_cast<unsigned int>(mIKChain.size());
@@ -41,9 +57,13 @@ bool ik_ccd(
 	const auto last = size - 1;
 	float thresholdSq = mThreshold * mThreshold;
 	vec3 goal = target.position;
+	auto& worlds = scratch.world_transforms;
 	for (unsigned int i = 0; i < mNumSteps; ++i)
 	{
-		vec3 effector = GetGlobalTransform(mIKChain, last).position;
+		// the sweep goes from the end towards the root, so a joint and its parents are still
+		// where they were at the start of the sweep when it is rotated
+		GetGlobalTransforms(mIKChain, worlds);
+		vec3 effector = worlds[last].position;
 		if (get_length_sq(goal - effector) < thresholdSq)
 		{
 			return true;
@@ -51,9 +71,7 @@ bool ik_ccd(
 
 		for (int j = static_cast<int>(size) - 2; j >= 0; --j)
 		{
-			effector = GetGlobalTransform(mIKChain, last).position;
-
-			Transform world = GetGlobalTransform(mIKChain, static_cast<unsigned int>(j));
+			const auto& world = worlds[static_cast<std::size_t>(j)];
 			vec3 position = world.position;
 			quat rotation = world.rotation;
 
@@ -81,12 +99,14 @@ bool ik_ccd(
 	return false;
 }
 
-std::vector<float> IKChainToWorld(
-	const std::vector<Transform>& mIKChain, std::vector<vec3>& mWorldChain
+void IKChainToWorld(
+	const std::vector<Transform>& mIKChain,
+	std::vector<vec3>& mWorldChain,
+	std::vector<float>& mLengths
 )
 {
 	const auto size = mIKChain.size();
-	std::vector<float> mLengths;
+	mWorldChain.resize(size);
 	mLengths.resize(size);
 
 	for (unsigned int i = 0; i < size; ++i)
@@ -105,8 +125,6 @@ std::vector<float> IKChainToWorld(
 	{
 		mLengths[0] = 0.0f;
 	}
-
-	return mLengths;
 }
 
 void WorldToIKChain(std::vector<Transform>& mIKChain, const std::vector<vec3>& mWorldChain)
@@ -139,7 +157,8 @@ bool ik_fabrik(
 	std::vector<Transform>& mIKChain,
 	const Transform& target,
 	unsigned int mNumSteps,
-	float mThreshold
+	float mThreshold,
+	IkScratch& scratch
 )
 {
 	const auto size = mIKChain.size();
@@ -148,13 +167,13 @@ bool ik_fabrik(
 		return false;
 	}
 
-	std::vector<vec3> mWorldChain;
-	mWorldChain.resize(size);
+	IKChainToWorld(mIKChain, scratch.world_chain, scratch.lengths);
+	auto& mWorldChain = scratch.world_chain;
+	const auto& mLengths = scratch.lengths;
 
 	const auto last = size - 1;
 	const auto thresholdSq = mThreshold * mThreshold;
 
-	const auto mLengths = IKChainToWorld(mIKChain, mWorldChain);
 	const auto goal = target.position;
 	const auto base = mWorldChain[0];
 
@@ -7,25 +7,47 @@
 constexpr unsigned int DEFAULT_NUM_STEPS = 15;
 constexpr float DEFAULT_THRESHOLD = 0.00001f;
 
+/// memory the solvers reuse between calls so solving doesn't allocate once it has grown
+struct IkScratch
+{
+	std::vector<vec3> world_chain;
+	std::vector<float> lengths;
+	std::vector<Transform> world_transforms;
+};
+
 using IkFunction = bool (*)(
 	std::vector<Transform>& mIKChain,
 	const Transform& target,
 	unsigned int mNumSteps,
-	float mThreshold
+	float mThreshold,
+	IkScratch& scratch
 );
 
 bool ik_ccd(
 	std::vector<Transform>& mIKChain,
 	const Transform& target,
 	unsigned int mNumSteps,
-	float mThreshold
+	float mThreshold,
+	IkScratch& scratch
 );
 
 bool ik_fabrik(
 	std::vector<Transform>& mIKChain,
 	const Transform& target,
 	unsigned int mNumSteps,
-	float mThreshold
+	float mThreshold,
+	IkScratch& scratch
 );
 
 std::vector<vec3> GetGlobalTransforms(const std::vector<Transform>& mIKChain);
+void GetGlobalTransforms(const std::vector<Transform>& mIKChain, std::vector<vec3>& positions);
+
+/// the world transform of every joint, each built from the one before instead of from the root
+void GetGlobalTransforms(const std::vector<Transform>& mIKChain, std::vector<Transform>& world);
+
+/// the world position of every joint and the distance to the joint before it
+void IKChainToWorld(
+	const std::vector<Transform>& mIKChain,
+	std::vector<vec3>& mWorldChain,
+	std::vector<float>& mLengths
+);
@@ -87,26 +87,25 @@ void IKLeg::SolveForLeg(
 	IkFunction ik_solver, const Transform& model, Pose& pose, const vec3& ankleTargetPosition
 )
 {
-	auto local_transforms = std::vector<Transform>{
-		get_combined(model, calc_global_transform(pose, mHipIndex)),
-		pose[mKneeIndex].local,
-		pose[mAnkleIndex].local
-	};
+	mChain.resize(3);
+	mChain[0] = get_combined(model, calc_global_transform(pose, mHipIndex));
+	mChain[1] = pose[mKneeIndex].local;
+	mChain[2] = pose[mAnkleIndex].local;
 	mIKPose = pose;
 
 	Transform target(
 		ankleTargetPosition + vec3(0, 1, 0) * mAnkleToGroundOffset, quat(), vec3(1, 1, 1)
 	);
-	ik_solver(local_transforms, target, DEFAULT_NUM_STEPS, DEFAULT_THRESHOLD);
+	ik_solver(mChain, target, DEFAULT_NUM_STEPS, DEFAULT_THRESHOLD, mScratch);
 
 	Transform rootWorld = get_combined(model, calc_global_transform(pose, *pose[mHipIndex].parent));
-	mIKPose[mHipIndex].local = get_combined(get_inverse(rootWorld), local_transforms[0]);
-	mIKPose[mKneeIndex].local = local_transforms[1];
-	mIKPose[mAnkleIndex].local = local_transforms[2];
+	mIKPose[mHipIndex].local = get_combined(get_inverse(rootWorld), mChain[0]);
+	mIKPose[mKneeIndex].local = mChain[1];
+	mIKPose[mAnkleIndex].local = mChain[2];
 
-	const auto global_transforms = GetGlobalTransforms(local_transforms);
-	mLineVisuals->LinesFromIKSolver(global_transforms);
-	mPointVisuals->PointsFromIKSolver(global_transforms);
+	GetGlobalTransforms(mChain, mChainPositions);
+	mLineVisuals->LinesFromIKSolver(mChainPositions);
+	mPointVisuals->PointsFromIKSolver(mChainPositions);
 }
 
 Pose& IKLeg::GetAdjustedPose()
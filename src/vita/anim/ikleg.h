@@ -9,6 +9,11 @@ struct IKLeg
 {
 	Pose mIKPose;
 
+	// reused between solves
+	std::vector<Transform> mChain;
+	std::vector<vec3> mChainPositions;
+	IkScratch mScratch;
+
 	std::size_t mHipIndex;
 	std::size_t mKneeIndex;
 	std::size_t mAnkleIndex;
@@ -1,5 +1,9 @@
 #include "vita/anim/indexbuffer.h"
 
+#include "vita/glstate.h"
+
+#include <utility>
+
 IndexBuffer::IndexBuffer()
 	: handle(0)
 	, count(0)
@@ -9,7 +13,28 @@ IndexBuffer::IndexBuffer()
 
 IndexBuffer::~IndexBuffer()
 {
-	glDeleteBuffers(1, &handle);
+	if (handle != 0)
+	{
+		glstate::invalidate();
+		glDeleteBuffers(1, &handle);
+	}
+}
+
+IndexBuffer::IndexBuffer(IndexBuffer&& other) noexcept
+	: handle(std::exchange(other.handle, 0))
+	, count(std::exchange(other.count, 0))
+{
+}
+
+IndexBuffer& IndexBuffer::operator=(IndexBuffer&& other) noexcept
+{
+	if (this != &other)
+	{
+		IndexBuffer old{std::move(*this)};
+		handle = std::exchange(other.handle, 0);
+		count = std::exchange(other.count, 0);
+	}
+	return *this;
 }
 
 void IndexBuffer::set_array(const unsigned int* inputArray, unsigned int arrayLength)
@@ -17,9 +42,9 @@ void IndexBuffer::set_array(const unsigned int* inputArray, unsigned int arrayLe
 	count = arrayLength;
 	const auto size = sizeof(unsigned int);
 
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, handle);
+	glstate::bind_buffer(GL_ELEMENT_ARRAY_BUFFER, handle);
 	glBufferData(GL_ELEMENT_ARRAY_BUFFER, size * count, inputArray, GL_STATIC_DRAW);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	glstate::count_calls(1);
 }
 
 void IndexBuffer::set(const std::vector<unsigned int>& input)
@@ -10,8 +10,8 @@ struct IndexBuffer
 
 	IndexBuffer(const IndexBuffer& other) = delete;
 	void operator=(const IndexBuffer& other) = delete;
-	IndexBuffer(IndexBuffer&& other) = delete;
-	void operator=(IndexBuffer&& other) = delete;
+	IndexBuffer(IndexBuffer&& other) noexcept;
+	IndexBuffer& operator=(IndexBuffer&& other) noexcept;
 
 	void set_array(const unsigned int* inputArray, unsigned int arrayLength);
 	void set(const std::vector<unsigned int>& input);
@@ -0,0 +1,224 @@
+#include "vita/anim/keyreduction.h"
+
+#include "vita/str.h"
+#include "vita/anim/tracksampling.h"
+
+#include <cmath>
+#include <utility>
+
+namespace
+{
+float get_key_error(float lhs, float rhs)
+{
+	return std::abs(lhs - rhs);
+}
+
+float get_key_error(const vec3& lhs, const vec3& rhs)
+{
+	return std::sqrt(get_length_sq(lhs - rhs));
+}
+
+float get_key_error(const quat& lhs, const quat& rhs)
+{
+	return get_angle_between(lhs, rhs);
+}
+
+/// sample the segment between two keys as if all keys between them were removed
+template<typename T>
+T sample_segment(const Track<T>& track, std::size_t first, std::size_t last, float time)
+{
+	const auto& this_frame = track.frames[first];
+	const auto& next_frame = track.frames[last];
+	const auto frame_delta = next_frame.time - this_frame.time;
+	const auto t = frame_delta > 0.0f ? (time - this_frame.time) / frame_delta : 0.0f;
+
+	switch (track.interpolation)
+	{
+	case Interpolation::Linear:
+		return linear_track_helpers::interpolate(this_frame.value, next_frame.value, t);
+	case Interpolation::Cubic:
+		return calc_hermite_interpolation(
+			t,
+			this_frame.value,
+			this_frame.out * frame_delta,
+			next_frame.value,
+			next_frame.in * frame_delta
+		);
+	default:
+	case Interpolation::Constant: return this_frame.value;
+	}
+}
+
+/// the original track at every key and halfway to the next key, sampled once per track
+template<typename T>
+struct OriginalSamples
+{
+	std::vector<T> at_key;
+	std::vector<T> halfway;
+};
+
+template<typename T>
+OriginalSamples<T> sample_original(const Track<T>& track)
+{
+	const auto& frames = track.frames;
+	OriginalSamples<T> result;
+	result.at_key.reserve(frames.size());
+	result.halfway.reserve(frames.size());
+	for (std::size_t index = 0; index < frames.size(); ++index)
+	{
+		const auto key_time = frames[index].time;
+		const auto next_time = index + 1 < frames.size() ? frames[index + 1].time : key_time;
+		result.at_key.emplace_back(track.get_sample(key_time, false));
+		result.halfway.emplace_back(track.get_sample((key_time + next_time) * 0.5f, false));
+	}
+	return result;
+}
+
+struct SegmentError
+{
+	float error = 0.0f;
+
+	/// the inner key closest to the largest error, where the segment is split
+	std::size_t worst = 0;
+};
+
+/// the largest difference between the original track and the segment, checked at every key that
+/// would be removed and halfway between all keys since cubic and quaternion curves can bend there
+template<typename T>
+SegmentError get_segment_error(
+	const Track<T>& track, const OriginalSamples<T>& original, std::size_t first, std::size_t last
+)
+{
+	SegmentError result;
+	result.worst = first + 1;
+	const auto add = [&](const T& expected, float time, std::size_t key)
+	{
+		const auto error = get_key_error(expected, sample_segment(track, first, last, time));
+		if ((error <= result.error) == false)
+		{
+			result.error = error;
+			result.worst = key;
+		}
+	};
+
+	for (auto index = first; index < last; ++index)
+	{
+		const auto key_time = track.frames[index].time;
+		const auto half_time = (key_time + track.frames[index + 1].time) * 0.5f;
+		if (index > first)
+		{
+			add(original.at_key[index], key_time, index);
+		}
+		add(original.halfway[index], half_time, index > first ? index : index + 1);
+	}
+	return result;
+}
+}  //  namespace
+
+template<typename T>
+KeyReduction reduce_keys(Track<T>& track, float tolerance)
+{
+	KeyReduction result;
+	result.keys_before = track.frames.size();
+	result.keys_after = track.frames.size();
+
+	const auto number_of_frames = track.frames.size();
+	if (number_of_frames <= 2)
+	{
+		return result;
+	}
+
+	// split every segment at its worst key until all of them are within the tolerance, each
+	// segment is checked once so a track that is already a straight line costs a single pass
+	const auto original = sample_original(track);
+	std::vector<bool> keep(number_of_frames, false);
+	keep[0] = true;
+	keep[number_of_frames - 1] = true;
+
+	std::vector<std::pair<std::size_t, std::size_t>> segments;
+	segments.emplace_back(0, number_of_frames - 1);
+	while (segments.empty() == false)
+	{
+		const auto [first, last] = segments.back();
+		segments.pop_back();
+		if (last - first < 2)
+		{
+			continue;
+		}
+
+		const auto segment = get_segment_error(track, original, first, last);
+		if (segment.error <= tolerance)
+		{
+			result.max_error = std::max(result.max_error, segment.error);
+			continue;
+		}
+
+		keep[segment.worst] = true;
+		segments.emplace_back(first, segment.worst);
+		segments.emplace_back(segment.worst, last);
+	}
+
+	std::vector<Frame<T>> kept;
+	for (std::size_t index = 0; index < number_of_frames; ++index)
+	{
+		if (keep[index])
+		{
+			kept.emplace_back(track.frames[index]);
+		}
+	}
+
+	track.frames = kept;
+	result.keys_after = kept.size();
+	return result;
+}
+
+std::vector<TransformTrackKeyReduction> reduce_keys(
+	Clip& clip, const KeyReductionTolerance& tolerance
+)
+{
+	std::vector<TransformTrackKeyReduction> result;
+	result.reserve(clip.tracks.size());
+
+	for (auto& track: clip.tracks)
+	{
+		TransformTrackKeyReduction reduction;
+		reduction.id = track.id;
+		reduction.position = reduce_keys(track.position, tolerance.position);
+		reduction.rotation = reduce_keys(track.rotation, tolerance.rotation);
+		reduction.scale = reduce_keys(track.scale, tolerance.scale);
+		result.emplace_back(reduction);
+	}
+
+	clip.duration = duration_from_tracks(clip.tracks);
+	return result;
+}
+
+std::string to_string(const std::vector<TransformTrackKeyReduction>& report)
+{
+	std::size_t before = 0;
+	std::size_t after = 0;
+
+	auto str = Str{};
+	for (const auto& track: report)
+	{
+		str << "track " << track.id;
+		for (const auto& [name, reduction]:
+			 {std::make_pair("position", track.position),
+			  std::make_pair("rotation", track.rotation),
+			  std::make_pair("scale", track.scale)})
+		{
+			str << ", " << name << " " << reduction.keys_before << " -> " << reduction.keys_after
+				<< " (error " << reduction.max_error << ")";
+			before += reduction.keys_before;
+			after += reduction.keys_after;
+		}
+		str << "\n";
+	}
+	str << "total " << before << " -> " << after << " keys\n";
+
+	return str;
+}
+
+template KeyReduction reduce_keys(Track<float>& track, float tolerance);
+template KeyReduction reduce_keys(Track<vec3>& track, float tolerance);
+template KeyReduction reduce_keys(Track<quat>& track, float tolerance);
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include "vita/anim/clip.h"
+
+/// how far the reduced tracks are allowed to be from the original
+struct KeyReductionTolerance
+{
+	float position = 0.001f;
+
+	/// in radians
+	float rotation = 0.0005f;
+
+	float scale = 0.0001f;
+};
+
+struct KeyReduction
+{
+	std::size_t keys_before = 0;
+	std::size_t keys_after = 0;
+
+	/// in radians for rotation tracks
+	float max_error = 0.0f;
+};
+
+struct TransformTrackKeyReduction
+{
+	std::size_t id = 0;
+	KeyReduction position;
+	KeyReduction rotation;
+	KeyReduction scale;
+};
+
+/// remove the keys the interpolation can rebuild from the neighbouring keys within the tolerance
+template<typename T>
+KeyReduction reduce_keys(Track<T>& track, float tolerance);
+
+std::vector<TransformTrackKeyReduction> reduce_keys(
+	Clip& clip, const KeyReductionTolerance& tolerance
+);
+std::string to_string(const std::vector<TransformTrackKeyReduction>& report);
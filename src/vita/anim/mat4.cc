@@ -3,118 +3,6 @@
 #include <cmath>
 #include <iostream>
 
-const float* mat4::data_ptr() const
-{
-	return &xx;
-}
-
-mat4::mat4()
-	: xx(1)
-	, xy(0)
-	, xz(0)
-	, xw(0)
-	, yx(0)
-	, yy(1)
-	, yz(0)
-	, yw(0)
-	, zx(0)
-	, zy(0)
-	, zz(1)
-	, zw(0)
-	, tx(0)
-	, ty(0)
-	, tz(0)
-	, tw(1)
-{
-}
-
-mat4::mat4(float* fv)
-	: xx(fv[0])
-	, xy(fv[1])
-	, xz(fv[2])
-	, xw(fv[3])
-	, yx(fv[4])
-	, yy(fv[5])
-	, yz(fv[6])
-	, yw(fv[7])
-	, zx(fv[8])
-	, zy(fv[9])
-	, zz(fv[10])
-	, zw(fv[11])
-	, tx(fv[12])
-	, ty(fv[13])
-	, tz(fv[14])
-	, tw(fv[15])
-{
-}
-
-mat4::mat4(
-	float _00,
-	float _01,
-	float _02,
-	float _03,
-	float _10,
-	float _11,
-	float _12,
-	float _13,
-	float _20,
-	float _21,
-	float _22,
-	float _23,
-	float _30,
-	float _31,
-	float _32,
-	float _33
-)
-	: xx(_00)
-	, xy(_01)
-	, xz(_02)
-	, xw(_03)
-	, yx(_10)
-	, yy(_11)
-	, yz(_12)
-	, yw(_13)
-	, zx(_20)
-	, zy(_21)
-	, zz(_22)
-	, zw(_23)
-	, tx(_30)
-	, ty(_31)
-	, tz(_32)
-	, tw(_33)
-{
-}
-
-float mat4::operator[](int i) const
-{
-	return *(&xx + i);
-}
-
-float& mat4::operator[](int i)
-{
-	return *(&xx + i);
-}
-
-vec4 mat4::right() const
-{
-	return {xx, xy, xz, xw};
-}
-
-vec4 mat4::up() const
-{
-	return {yx, yy, yz, yw};
-}
-
-vec4 mat4::forward() const
-{
-	return {zx, zy, zz, zw};
-}
-
-vec4 mat4::position() const
-{
-	return {tx, ty, tz, tw};
-}
-
 bool operator==(const mat4& a, const mat4& b)
 {
 	for (int i = 0; i < 16; ++i)
@@ -176,59 +64,9 @@ mat4 operator+(const mat4& a, const mat4& b)
 	);
 }
 
-#define M4D(aRow, bCol) \
-	a[0 * 4 + aRow] * b[bCol * 4 + 0] + a[1 * 4 + aRow] * b[bCol * 4 + 1] \
-		+ a[2 * 4 + aRow] * b[bCol * 4 + 2] + a[3 * 4 + aRow] * b[bCol * 4 + 3]
-
-mat4 operator*(const mat4& a, const mat4& b)
-{
-	return mat4(
-		M4D(0, 0),
-		M4D(1, 0),
-		M4D(2, 0),
-		M4D(3, 0),	// Column 0
-		M4D(0, 1),
-		M4D(1, 1),
-		M4D(2, 1),
-		M4D(3, 1),	// Column 1
-		M4D(0, 2),
-		M4D(1, 2),
-		M4D(2, 2),
-		M4D(3, 2),	// Column 2
-		M4D(0, 3),
-		M4D(1, 3),
-		M4D(2, 3),
-		M4D(3, 3)  // Column 3
-	);
-}
-
 #define M4V4D(mRow, x, y, z, w) \
 	x* m[0 * 4 + mRow] + y* m[1 * 4 + mRow] + z* m[2 * 4 + mRow] + w* m[3 * 4 + mRow]
 
-vec4 operator*(const mat4& m, const vec4& v)
-{
-	return vec4(
-		M4V4D(0, v.x, v.y, v.z, v.w),
-		M4V4D(1, v.x, v.y, v.z, v.w),
-		M4V4D(2, v.x, v.y, v.z, v.w),
-		M4V4D(3, v.x, v.y, v.z, v.w)
-	);
-}
-
-vec3 get_transformed_vector(const mat4& m, const vec3& v)
-{
-	return vec3(
-		M4V4D(0, v.x, v.y, v.z, 0.0f), M4V4D(1, v.x, v.y, v.z, 0.0f), M4V4D(2, v.x, v.y, v.z, 0.0f)
-	);
-}
-
-vec3 get_transformed_point(const mat4& m, const vec3& v)
-{
-	return vec3(
-		M4V4D(0, v.x, v.y, v.z, 1.0f), M4V4D(1, v.x, v.y, v.z, 1.0f), M4V4D(2, v.x, v.y, v.z, 1.0f)
-	);
-}
-
 vec3 get_transformed_point(const mat4& m, const vec3& v, float& w)
 {
 	float _w = w;
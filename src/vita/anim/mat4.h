@@ -10,15 +10,40 @@ constexpr float MAT4_EPSILON = 0.000001f;
 struct mat4
 {
 	// float v[16];
-	float operator[](int i) const;
-	float& operator[](int i);
-
-	vec4 right() const;
-	vec4 up() const;
-	vec4 forward() const;
-	vec4 position() const;
-
-	const float* data_ptr() const;
+	float operator[](int i) const
+	{
+		return *(&xx + i);
+	}
+
+	float& operator[](int i)
+	{
+		return *(&xx + i);
+	}
+
+	constexpr vec4 right() const
+	{
+		return {xx, xy, xz, xw};
+	}
+
+	constexpr vec4 up() const
+	{
+		return {yx, yy, yz, yw};
+	}
+
+	constexpr vec4 forward() const
+	{
+		return {zx, zy, zz, zw};
+	}
+
+	constexpr vec4 position() const
+	{
+		return {tx, ty, tz, tw};
+	}
+
+	constexpr const float* data_ptr() const
+	{
+		return &xx;
+	}
 
 	// row 1     row 2     row 3     row 4
 	/* column 1 */
@@ -87,11 +112,47 @@ struct mat4
 
 	// Include constructors here
 
-	mat4();
-
-	explicit mat4(float* fv);
-
-	mat4(
+	constexpr mat4()
+		: xx(1)
+		, xy(0)
+		, xz(0)
+		, xw(0)
+		, yx(0)
+		, yy(1)
+		, yz(0)
+		, yw(0)
+		, zx(0)
+		, zy(0)
+		, zz(1)
+		, zw(0)
+		, tx(0)
+		, ty(0)
+		, tz(0)
+		, tw(1)
+	{
+	}
+
+	constexpr explicit mat4(float* fv)
+		: xx(fv[0])
+		, xy(fv[1])
+		, xz(fv[2])
+		, xw(fv[3])
+		, yx(fv[4])
+		, yy(fv[5])
+		, yz(fv[6])
+		, yw(fv[7])
+		, zx(fv[8])
+		, zy(fv[9])
+		, zz(fv[10])
+		, zw(fv[11])
+		, tx(fv[12])
+		, ty(fv[13])
+		, tz(fv[14])
+		, tw(fv[15])
+	{
+	}
+
+	constexpr mat4(
 		float _00,
 		float _01,
 		float _02,
@@ -108,7 +169,25 @@ struct mat4
 		float _31,
 		float _32,
 		float _33
-	);
+	)
+		: xx(_00)
+		, xy(_01)
+		, xz(_02)
+		, xw(_03)
+		, yx(_10)
+		, yy(_11)
+		, yz(_12)
+		, yw(_13)
+		, zx(_20)
+		, zy(_21)
+		, zz(_22)
+		, zw(_23)
+		, tx(_30)
+		, ty(_31)
+		, tz(_32)
+		, tw(_33)
+	{
+	}
 };
 
 static_assert(sizeof(mat4) == sizeof(float) * 16, "Invalid size");
@@ -118,11 +197,46 @@ bool operator==(const mat4& a, const mat4& b);
 bool operator!=(const mat4& a, const mat4& b);
 mat4 operator*(const mat4& m, float f);
 mat4 operator+(const mat4& a, const mat4& b);
-mat4 operator*(const mat4& a, const mat4& b);
-vec4 operator*(const mat4& m, const vec4& v);
 
-vec3 get_transformed_vector(const mat4& m, const vec3& v);
-vec3 get_transformed_point(const mat4& m, const vec3& v);
+// the products are inline so the palette and skinning loops don't pay a call per joint
+
+constexpr vec4 operator*(const mat4& m, const vec4& v)
+{
+	return vec4(
+		m.xx * v.x + m.yx * v.y + m.zx * v.z + m.tx * v.w,
+		m.xy * v.x + m.yy * v.y + m.zy * v.z + m.ty * v.w,
+		m.xz * v.x + m.yz * v.y + m.zz * v.z + m.tz * v.w,
+		m.xw * v.x + m.yw * v.y + m.zw * v.z + m.tw * v.w
+	);
+}
+
+constexpr mat4 operator*(const mat4& a, const mat4& b)
+{
+	const auto x = a * b.right();
+	const auto y = a * b.up();
+	const auto z = a * b.forward();
+	const auto t = a * b.position();
+	return mat4(x.x, x.y, x.z, x.w, y.x, y.y, y.z, y.w, z.x, z.y, z.z, z.w, t.x, t.y, t.z, t.w);
+}
+
+constexpr vec3 get_transformed_vector(const mat4& m, const vec3& v)
+{
+	return vec3(
+		m.xx * v.x + m.yx * v.y + m.zx * v.z,
+		m.xy * v.x + m.yy * v.y + m.zy * v.z,
+		m.xz * v.x + m.yz * v.y + m.zz * v.z
+	);
+}
+
+constexpr vec3 get_transformed_point(const mat4& m, const vec3& v)
+{
+	return vec3(
+		m.xx * v.x + m.yx * v.y + m.zx * v.z + m.tx,
+		m.xy * v.x + m.yy * v.y + m.zy * v.z + m.ty,
+		m.xz * v.x + m.yz * v.y + m.zz * v.z + m.tz
+	);
+}
+
 vec3 get_transformed_point(const mat4& m, const vec3& v, float& w);
 
 mat4 get_transposed(const mat4& m);
@@ -1,6 +1,7 @@
 #include "catch.hpp"
 
 #include "vita/anim/mat4.h"
+#include "vita/anim/transform.h"
 
 TEST_CASE("basic mat4 test")
 {
@@ -29,3 +30,16 @@ TEST_CASE("basic mat4 test")
 	// ERROR, expected inverse * matrix to be identity
 	CHECK(identity == mat4());
 }
+
+TEST_CASE("core math is usable at compile time")
+{
+	constexpr auto rotation = quat(0.0f, 0.0f, 0.70710678f, 0.70710678f);
+	constexpr auto transform = Transform(vec3(1, 2, 3), rotation, vec3(2, 2, 2));
+	constexpr auto matrix = mat4_from_transform(transform);
+	constexpr auto point = get_transformed_point(matrix, vec3(1, 0, 0));
+
+	static_assert(get_transformed_point(transform, vec3(1, 0, 0)) == point, "");
+	static_assert(point == vec3(1, 4, 3), "");
+	static_assert(dot(cross(vec3(1, 0, 0), vec3(0, 1, 0)), vec3(0, 0, 1)) == 1.0f, "");
+	CHECK(matrix * get_inverse(matrix) == mat4());
+}
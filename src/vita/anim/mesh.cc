@@ -2,25 +2,11 @@
 
 #include "vita/anim/draw.h"
 #include "vita/anim/transform.h"
-
-Mesh::Mesh()
-{
-	attribute_position = new Attribute<vec3>();
-	attribute_normal = new Attribute<vec3>();
-	attribute_textcoord = new Attribute<vec2>();
-	attribute_weights = new Attribute<vec4>();
-	attribute_influences = new Attribute<ivec4>();
-	index_buffer = new IndexBuffer();
-}
+#include "vita/glstate.h"
 
 Mesh::Mesh(const Mesh& other)
+	: Mesh()
 {
-	attribute_position = new Attribute<vec3>();
-	attribute_normal = new Attribute<vec3>();
-	attribute_textcoord = new Attribute<vec2>();
-	attribute_weights = new Attribute<vec4>();
-	attribute_influences = new Attribute<ivec4>();
-	index_buffer = new IndexBuffer();
 	*this = other;
 }
 
@@ -40,75 +26,125 @@ Mesh& Mesh::operator=(const Mesh& other)
 	return *this;
 }
 
-Mesh::~Mesh()
+namespace
+{
+/// the skinning inputs of the mesh, empty if it has no weights and influences for every vertex
+SoaSkinMesh make_skin_streams(const Mesh& mesh)
+{
+	const auto size = mesh.position.size();
+	const auto is_skinned = mesh.normal.size() == size && mesh.weights.size() == size
+						 && mesh.influences.size() == size;
+	return is_skinned
+			 ? make_soa_skin_mesh(mesh.position, mesh.normal, mesh.weights, mesh.influences)
+			 : SoaSkinMesh{};
+}
+
+/// the vertices can be replaced without calling UpdateOpenGLBuffers, rebuild the skinning inputs
+/// instead of skinning a copy with the wrong number of vertices. False if there is nothing to skin
+bool update_skin_streams(Mesh& mesh)
 {
-	delete attribute_position;
-	delete attribute_normal;
-	delete attribute_textcoord;
-	delete attribute_weights;
-	delete attribute_influences;
-	delete index_buffer;
+	if (mesh.skin_streams.size() != mesh.position.size())
+	{
+		mesh.skin_streams = make_skin_streams(mesh);
+	}
+	return mesh.skin_streams.size() > 0;
 }
+}  //  namespace
 
 void Mesh::UpdateOpenGLBuffers()
 {
+	skin_streams = make_skin_streams(*this);
+
 	if (position.size() > 0)
 	{
-		attribute_position->set(position);
+		attribute_position.set(position);
 	}
 	if (normal.size() > 0)
 	{
-		attribute_normal->set(normal);
+		attribute_normal.set(normal);
 	}
 	if (texcoord.size() > 0)
 	{
-		attribute_textcoord->set(texcoord);
+		attribute_textcoord.set(texcoord);
 	}
 	if (weights.size() > 0)
 	{
-		attribute_weights->set(weights);
+		attribute_weights.set(weights);
 	}
 	if (influences.size() > 0)
 	{
-		attribute_influences->set(influences);
+		attribute_influences.set(influences);
 	}
 	if (indices.size() > 0)
 	{
-		index_buffer->set(indices);
+		index_buffer.set(indices);
 	}
 }
 
-void Mesh::Bind(
-	int position_slot, int normal_slot, int texcoord_slot, int weights_slot, int influcences_slot
-)
+namespace
 {
-	if (position_slot >= 0)
-	{
-		attribute_position->bind_to(static_cast<unsigned int>(position_slot));
-	}
-	if (normal_slot >= 0)
-	{
-		attribute_normal->bind_to(static_cast<unsigned int>(normal_slot));
-	}
-	if (texcoord_slot >= 0)
+template<typename T>
+void unbind_slot(Attribute<T>& attribute, int slot)
+{
+	if (slot >= 0)
 	{
-		attribute_textcoord->bind_to(static_cast<unsigned int>(texcoord_slot));
+		attribute.unbind_from(static_cast<unsigned int>(slot));
 	}
-	if (weights_slot >= 0)
+}
+
+template<typename T>
+void bind_slot(Attribute<T>& attribute, int slot)
+{
+	if (slot >= 0)
 	{
-		attribute_weights->bind_to(static_cast<unsigned int>(weights_slot));
+		attribute.bind_to(static_cast<unsigned int>(slot));
 	}
-	if (influcences_slot >= 0)
+}
+}  //  namespace
+
+void Mesh::Bind(
+	int position_slot, int normal_slot, int texcoord_slot, int weights_slot, int influcences_slot
+)
+{
+	vertex_array.bind();
+
+	const auto slots = std::array<int, 5>{
+		position_slot, normal_slot, texcoord_slot, weights_slot, influcences_slot
+	};
+	if (slots == vertex_array_slots)
 	{
-		attribute_influences->bind_to(static_cast<unsigned int>(influcences_slot));
+		// cpu skinned vertices move to the next region of the streaming buffer every frame
+		if (attribute_position.is_streaming)
+		{
+			bind_slot(attribute_position, position_slot);
+		}
+		if (attribute_normal.is_streaming)
+		{
+			bind_slot(attribute_normal, normal_slot);
+		}
+		return;
 	}
+
+	// a shader with other slots, disable all the old ones before a slot is reused
+	unbind_slot(attribute_position, vertex_array_slots[0]);
+	unbind_slot(attribute_normal, vertex_array_slots[1]);
+	unbind_slot(attribute_textcoord, vertex_array_slots[2]);
+	unbind_slot(attribute_weights, vertex_array_slots[3]);
+	unbind_slot(attribute_influences, vertex_array_slots[4]);
+
+	bind_slot(attribute_position, position_slot);
+	bind_slot(attribute_normal, normal_slot);
+	bind_slot(attribute_textcoord, texcoord_slot);
+	bind_slot(attribute_weights, weights_slot);
+	bind_slot(attribute_influences, influcences_slot);
+	vertex_array_slots = slots;
 }
 
 void Mesh::Draw()
 {
 	if (indices.size() > 0)
 	{
-		::draw(*index_buffer, DrawMode::Triangles);
+		::draw(index_buffer, DrawMode::Triangles);
 	}
 	else
 	{
@@ -120,7 +156,7 @@ void Mesh::DrawInstanced(unsigned int numInstances)
 {
 	if (indices.size() > 0)
 	{
-		::draw_instanced(*index_buffer, DrawMode::Triangles, numInstances);
+		::draw_instanced(index_buffer, DrawMode::Triangles, numInstances);
 	}
 	else
 	{
@@ -130,73 +166,175 @@ void Mesh::DrawInstanced(unsigned int numInstances)
 	}
 }
 
-void Mesh::UnBind(
-	int position_slot, int normal_slot, int texcoord_slot, int weights_slot, int influcences_slot
-)
+void Mesh::UnBind(int, int, int, int, int)
+{
+	glstate::bind_default_vertex_array();
+}
+
+void remap_joints(Mesh& mesh, const JointOrder& order)
 {
-	if (position_slot >= 0)
+	const auto remap = [&order](int joint)
 	{
-		attribute_position->unbind_from(static_cast<unsigned int>(position_slot));
+		return static_cast<int>(order.new_index[static_cast<std::size_t>(joint)]);
+	};
+
+	for (auto& influence: mesh.influences)
+	{
+		influence = ivec4(
+			remap(influence.x), remap(influence.y), remap(influence.z), remap(influence.w)
+		);
 	}
-	if (normal_slot >= 0)
+}
+
+#if 1
+void calc_skin_palette(
+	const std::vector<mat4>& pose_palette,
+	const std::vector<mat4>& inverse_bind_pose,
+	std::vector<mat4>& skin_palette
+)
+{
+	const auto size = pose_palette.size();
+	skin_palette.resize(size);
+
+	for (std::size_t i = 0; i < size; ++i)
 	{
-		attribute_normal->unbind_from(static_cast<unsigned int>(normal_slot));
+		skin_palette[i] = pose_palette[i] * inverse_bind_pose[i];
 	}
-	if (texcoord_slot >= 0)
+}
+
+void calc_skin_palette(
+	const std::vector<affine3x4>& pose_palette,
+	const std::vector<affine3x4>& inverse_bind_pose,
+	std::vector<affine3x4>& skin_palette
+)
+{
+	const auto size = pose_palette.size();
+	skin_palette.resize(size);
+
+	for (std::size_t i = 0; i < size; ++i)
 	{
-		attribute_textcoord->unbind_from(static_cast<unsigned int>(texcoord_slot));
+		skin_palette[i] = pose_palette[i] * inverse_bind_pose[i];
 	}
-	if (weights_slot >= 0)
+}
+
+void skin_vertices(
+	const std::vector<vec3>& position,
+	const std::vector<vec3>& normal,
+	const std::vector<vec4>& weights,
+	const std::vector<ivec4>& influences,
+	const std::vector<mat4>& skin_palette,
+	std::vector<vec3>& skinned_position,
+	std::vector<vec3>& skinned_normal
+)
+{
+	const auto numVerts = position.size();
+	skinned_position.resize(numVerts);
+	skinned_normal.resize(numVerts);
+
+	for (std::size_t i = 0; i < numVerts; ++i)
 	{
-		attribute_weights->unbind_from(static_cast<unsigned int>(weights_slot));
+		const auto& j = influences[i];
+		const auto& w = weights[i];
+
+		mat4 skin = skin_palette[static_cast<std::size_t>(j.x)] * w.x
+				  + skin_palette[static_cast<std::size_t>(j.y)] * w.y
+				  + skin_palette[static_cast<std::size_t>(j.z)] * w.z
+				  + skin_palette[static_cast<std::size_t>(j.w)] * w.w;
+
+		skinned_position[i] = get_transformed_point(skin, position[i]);
+		skinned_normal[i] = get_transformed_vector(skin, normal[i]);
 	}
-	if (influcences_slot >= 0)
+}
+
+void calc_skin_palette(
+	const std::vector<DualQuaternion>& pose_palette,
+	const std::vector<DualQuaternion>& inverse_bind_pose,
+	std::vector<DualQuaternion>& skin_palette
+)
+{
+	const auto size = pose_palette.size();
+	skin_palette.resize(size);
+
+	for (std::size_t i = 0; i < size; ++i)
 	{
-		attribute_influences->unbind_from(static_cast<unsigned int>(influcences_slot));
+		skin_palette[i] = inverse_bind_pose[i] * pose_palette[i];
 	}
 }
 
-#if 1
 void Mesh::CPUSkin(Skeleton& skeleton, Pose& pose)
 {
-	const auto numVerts = position.size();
-	if (numVerts == 0)
+	if (update_skin_streams(*this) == false)
 	{
 		return;
 	}
 
-	skinned_position.resize(numVerts);
-	skinned_normal.resize(numVerts);
+	calc_matrix_palette(pose, pose_palette);
+	calc_skin_palette(pose_palette, skeleton.inverse_bind_pose, skin_palette);
+	skinned_position.resize(skin_streams.size());
+	skinned_normal.resize(skin_streams.size());
+	soa_skin::skin_range(
+		skin_streams,
+		skin_palette,
+		0,
+		skin_streams.size(),
+		skinned_position.data(),
+		skinned_normal.data()
+	);
 
-	pose_palette = calc_matrix_palette(pose);
-	std::vector<mat4> invPosePalette = skeleton.inverse_bind_pose;
+	upload_skinned_vertices();
+}
 
-	for (std::size_t i = 0; i < numVerts; ++i)
+void Mesh::CPUSkin(jobs::JobSystem& job_system, Skeleton& skeleton, Pose& pose)
+{
+	if (update_skin_streams(*this) == false)
 	{
-		const auto& j = influences[i];
-		const auto& w = weights[i];
+		return;
+	}
 
-		mat4 m0 = (pose_palette[static_cast<std::size_t>(j.x)]
-				   * invPosePalette[static_cast<std::size_t>(j.x)])
-				* w.x;
-		mat4 m1 = (pose_palette[static_cast<std::size_t>(j.y)]
-				   * invPosePalette[static_cast<std::size_t>(j.y)])
-				* w.y;
-		mat4 m2 = (pose_palette[static_cast<std::size_t>(j.z)]
-				   * invPosePalette[static_cast<std::size_t>(j.z)])
-				* w.z;
-		mat4 m3 = (pose_palette[static_cast<std::size_t>(j.w)]
-				   * invPosePalette[static_cast<std::size_t>(j.w)])
-				* w.w;
-
-		mat4 skin = m0 + m1 + m2 + m3;
+	calc_matrix_palette(pose, pose_palette);
+	calc_skin_palette(pose_palette, skeleton.inverse_bind_pose, skin_palette);
+	soa_skin::skin_vertices(
+		job_system, skin_streams, skin_palette, skinned_position, skinned_normal
+	);
 
-		skinned_position[i] = get_transformed_point(skin, position[i]);
-		skinned_normal[i] = get_transformed_vector(skin, normal[i]);
+	upload_skinned_vertices();
+}
+
+void Mesh::CPUSkinDualQuaternion(Skeleton& skeleton, Pose& pose)
+{
+	if (update_skin_streams(*this) == false)
+	{
+		return;
 	}
 
-	attribute_position->set(skinned_position);
-	attribute_normal->set(skinned_normal);
+	calc_dual_quaternion_palette(pose, pose_dual_quaternions);
+	calc_skin_palette(
+		pose_dual_quaternions, skeleton.inverse_bind_dual_quaternions, skin_dual_quaternions
+	);
+
+	skinned_position.resize(skin_streams.size());
+	skinned_normal.resize(skin_streams.size());
+	soa_skin::skin_range(
+		skin_streams,
+		skin_dual_quaternions,
+		0,
+		skin_streams.size(),
+		skinned_position.data(),
+		skinned_normal.data()
+	);
+
+	upload_skinned_vertices();
+}
+
+void Mesh::upload_skinned_vertices()
+{
+	// rewritten every frame, so stream instead of reallocating the buffers
+	attribute_position.enable_streaming();
+	attribute_normal.enable_streaming();
+
+	const auto count = static_cast<unsigned int>(skinned_position.size());
+	attribute_position.set_ptr(skinned_position.data(), count);
+	attribute_normal.set_ptr(skinned_normal.data(), count);
 }
 #else
 void Mesh::CPUSkin(Skeleton& skeleton, Pose& pose)
@@ -235,7 +373,7 @@ void Mesh::CPUSkin(Skeleton& skeleton, Pose& pose)
 		skinned_normal[i] = n0 * weight.x + n1 * weight.y + n2 * weight.z + n3 * weight.w;
 	}
 
-	attribute_position->Set(skinned_position);
-	attribute_normal->Set(skinned_normal);
+	attribute_position.Set(skinned_position);
+	attribute_normal.Set(skinned_normal);
 }
 #endif
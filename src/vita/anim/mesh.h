@@ -7,8 +7,10 @@
 #include <vector>
 #include "vita/anim/attribute.h"
 #include "vita/anim/indexbuffer.h"
+#include "vita/anim/vertexarray.h"
 #include "vita/anim/skeleton.h"
 #include "vita/anim/pose.h"
+#include "vita/anim/soaskin.h"
 
 struct Mesh
 {
@@ -20,30 +22,88 @@ struct Mesh
 
 	std::vector<unsigned int> indices;
 
-	Attribute<vec3>* attribute_position;
-	Attribute<vec3>* attribute_normal;
-	Attribute<vec2>* attribute_textcoord;
-	Attribute<vec4>* attribute_weights;
-	Attribute<ivec4>* attribute_influences;
+	Attribute<vec3> attribute_position;
+	Attribute<vec3> attribute_normal;
+	Attribute<vec2> attribute_textcoord;
+	Attribute<vec4> attribute_weights;
+	Attribute<ivec4> attribute_influences;
 
-	IndexBuffer* index_buffer;
+	IndexBuffer index_buffer;
 
-	std::vector<vec3> skinned_position;
-	std::vector<vec3> skinned_normal;
+	/// captures the attribute bindings, Bind only sets them up again when the slots change
+	VertexArray vertex_array;
+	std::array<int, 5> vertex_array_slots = {-1, -1, -1, -1, -1};
+
+	/// copy of the skinning inputs for CPUSkin, rebuilt by UpdateOpenGLBuffers or by CPUSkin when
+	/// the number of vertices changed
+	SoaSkinMesh skin_streams;
+
+	cpu::CacheAlignedVector<vec3> skinned_position;
+	cpu::CacheAlignedVector<vec3> skinned_normal;
 	std::vector<mat4> pose_palette;
+	std::vector<mat4> skin_palette;
+	std::vector<DualQuaternion> pose_dual_quaternions;
+	std::vector<DualQuaternion> skin_dual_quaternions;
 
-	Mesh();
-	Mesh(const Mesh&);
+	Mesh() = default;
 
+	/// a copy gets its own buffers and uploads the vertices again, a move takes over the buffers
+	Mesh(const Mesh&);
 	Mesh& operator=(const Mesh&);
-
-	~Mesh();
+	Mesh(Mesh&&) noexcept = default;
+	Mesh& operator=(Mesh&&) noexcept = default;
 
 	void CPUSkin(Skeleton& skeleton, Pose& pose);
+
+	/// CPUSkin with the vertices split across the job system, uploaded once all chunks are done
+	void CPUSkin(jobs::JobSystem& job_system, Skeleton& skeleton, Pose& pose);
+
+	/// CPUSkin with dual quaternions, keeps the volume around twisting joints but ignores scale
+	void CPUSkinDualQuaternion(Skeleton& skeleton, Pose& pose);
 	void UpdateOpenGLBuffers();
 
+	/// binds the vertex array of the mesh, attributes bound after this are part of it until UnBind
 	void Bind(int position, int normal, int texCoord, int weight, int influcence);
 	void Draw();
 	void DrawInstanced(unsigned int numInstances);
+	/// the slots stay enabled in the vertex array of the mesh, this goes back to the default one
 	void UnBind(int position, int normal, int texCoord, int weight, int influcence);
+
+	void upload_skinned_vertices();
 };
+
+/// remap the influences after the skeleton was reordered, call UpdateOpenGLBuffers to upload them
+void remap_joints(Mesh& mesh, const JointOrder& order);
+
+/// pose palette * inverse bind pose for every joint, combined once per joint instead of for every
+/// influence of every vertex
+void calc_skin_palette(
+	const std::vector<mat4>& pose_palette,
+	const std::vector<mat4>& inverse_bind_pose,
+	std::vector<mat4>& skin_palette
+);
+
+void calc_skin_palette(
+	const std::vector<affine3x4>& pose_palette,
+	const std::vector<affine3x4>& inverse_bind_pose,
+	std::vector<affine3x4>& skin_palette
+);
+
+/// the reference cpu skinning, soa_skin::skin_vertices is the faster version
+void skin_vertices(
+	const std::vector<vec3>& position,
+	const std::vector<vec3>& normal,
+	const std::vector<vec4>& weights,
+	const std::vector<ivec4>& influences,
+	const std::vector<mat4>& skin_palette,
+	std::vector<vec3>& skinned_position,
+	std::vector<vec3>& skinned_normal
+);
+
+/// inverse bind pose followed by the pose for every joint, the dual quaternion calc_skin_palette
+void calc_skin_palette(
+	const std::vector<DualQuaternion>& pose_palette,
+	const std::vector<DualQuaternion>& inverse_bind_pose,
+	std::vector<DualQuaternion>& skin_palette
+);
+
@@ -0,0 +1,224 @@
+#include "vita/anim/packedtrack.h"
+
+#include "vita/anim/tracksampling.h"
+#include "vita/anim/timesearch.h"
+
+#include <algorithm>
+
+namespace
+{
+/// the last time less or equal to the given time, -1 if before the first time
+int search_time_index(const std::vector<float>& times, float time)
+{
+	return time_search::find_index(times.data(), times.size(), time);
+}
+
+/// the time of a key, for the shared key searches
+auto get_key_times(const std::vector<float>& times)
+{
+	return [&times](int index) { return times[static_cast<std::size_t>(index)]; };
+}
+
+template<typename T>
+T get_packed_sample_constant(const PackedTrack<T>& track, int frame_index)
+{
+	if (frame_index < 0 || frame_index >= static_cast<int>(track.size()))
+	{
+		return T();
+	}
+
+	return track.values[static_cast<std::size_t>(frame_index)];
+}
+
+template<typename T>
+T get_packed_sample_linear(const PackedTrack<T>& track, int frame_index, float track_time)
+{
+	if (frame_index < 0 || frame_index >= static_cast<int>(track.size()) - 1)
+	{
+		return T();
+	}
+	const auto this_index = static_cast<std::size_t>(frame_index);
+	const auto next_index = this_index + 1;
+
+	const auto frame_delta = track.times[next_index] - track.times[this_index];
+	if (frame_delta <= 0.0f)
+	{
+		return T();
+	}
+
+	const auto t = (track_time - track.times[this_index]) / frame_delta;
+	return linear_track_helpers::interpolate(
+		track.values[this_index], track.values[next_index], t
+	);
+}
+
+template<typename T>
+T get_packed_sample_cubic(const PackedTrack<T>& track, int frame_index, float track_time)
+{
+	if (frame_index < 0 || frame_index >= static_cast<int>(track.size()) - 1)
+	{
+		return T();
+	}
+	const auto this_index = static_cast<std::size_t>(frame_index);
+	const auto next_index = this_index + 1;
+
+	if (track.out_tangents.size() <= this_index || track.in_tangents.size() <= next_index)
+	{
+		return T();
+	}
+
+	const auto frame_delta = track.times[next_index] - track.times[this_index];
+	if (frame_delta <= 0.0f)
+	{
+		return T();
+	}
+
+	const auto t = (track_time - track.times[this_index]) / frame_delta;
+
+	const auto point1 = track.values[this_index];
+	const auto slope1 = track.out_tangents[this_index] * frame_delta;
+
+	const auto point2 = track.values[next_index];
+	const auto slope2 = track.in_tangents[next_index] * frame_delta;
+
+	return calc_hermite_interpolation(t, point1, slope1, point2, slope2);
+}
+}  //  namespace
+
+template<typename T>
+PackedTrack<T>::PackedTrack(const std::vector<Frame<T>>& fra, Interpolation in)
+	: interpolation(in)
+{
+	resize(fra.size());
+	const auto cubic = interpolation == Interpolation::Cubic;
+	for (std::size_t i = 0; i < fra.size(); ++i)
+	{
+		times[i] = fra[i].time;
+		values[i] = fra[i].value;
+		if (cubic)
+		{
+			in_tangents[i] = fra[i].in;
+			out_tangents[i] = fra[i].out;
+		}
+	}
+}
+
+template<typename T>
+void PackedTrack<T>::resize(std::size_t number_of_frames)
+{
+	times.resize(number_of_frames);
+	values.resize(number_of_frames);
+
+	const auto tangents = interpolation == Interpolation::Cubic ? number_of_frames : 0;
+	in_tangents.resize(tangents);
+	out_tangents.resize(tangents);
+}
+
+template<typename T>
+std::size_t PackedTrack<T>::size() const
+{
+	return times.size();
+}
+
+template<typename T>
+bool PackedTrack<T>::is_valid() const
+{
+	return times.size() > 1;
+}
+
+template<typename T>
+float PackedTrack<T>::get_start_time() const
+{
+	return times[0];
+}
+
+template<typename T>
+float PackedTrack<T>::get_end_time() const
+{
+	return times[times.size() - 1];
+}
+
+template<typename T>
+T PackedTrack<T>::get_sample(float time, bool looping) const
+{
+	const auto track_time = adjust_time_to_fit(time, looping);
+	return get_sample_at_frame(get_frame_index(track_time, looping), track_time);
+}
+
+template<typename T>
+T PackedTrack<T>::get_sample(float time, bool looping, TrackCursor& cursor) const
+{
+	const auto track_time = adjust_time_to_fit(time, looping);
+	const auto number_of_frames = static_cast<int>(size());
+	const auto key_times = get_key_times(times);
+	const auto index = find_key_index(
+		number_of_frames,
+		track_time,
+		looping,
+		key_times,
+		[&](float t)
+		{
+			return search_key_from_cursor(
+				number_of_frames,
+				t,
+				cursor.frame,
+				key_times,
+				[this](float search_time) { return search_time_index(times, search_time); }
+			);
+		}
+	);
+	if (index >= 0)
+	{
+		cursor.frame = index;
+	}
+	return get_sample_at_frame(index, track_time);
+}
+
+template<typename T>
+float PackedTrack<T>::adjust_time_to_fit(float time, bool looping) const
+{
+	if (is_valid() == false)
+	{
+		return 0.0f;
+	}
+
+	return adjust_time_to_fit_range(get_start_time(), get_end_time(), time, looping);
+}
+
+template<typename T>
+int PackedTrack<T>::get_frame_index(float track_time, bool looping) const
+{
+	return find_key_index(
+		static_cast<int>(size()),
+		track_time,
+		looping,
+		get_key_times(times),
+		[this](float t) { return search_time_index(times, t); }
+	);
+}
+
+template<typename T>
+T PackedTrack<T>::get_sample_at_frame(int frame_index, float track_time) const
+{
+	switch (interpolation)
+	{
+	default:
+	case Interpolation::Constant: return get_packed_sample_constant(*this, frame_index);
+	case Interpolation::Linear: return get_packed_sample_linear(*this, frame_index, track_time);
+	case Interpolation::Cubic: return get_packed_sample_cubic(*this, frame_index, track_time);
+	}
+}
+
+template<typename T>
+PackedTrack<T> pack_track(const Track<T>& track)
+{
+	return PackedTrack<T>{track.frames, track.interpolation};
+}
+
+template struct PackedTrack<float>;
+template struct PackedTrack<vec3>;
+template struct PackedTrack<quat>;
+
+template PackedTrack<float> pack_track(const Track<float>& track);
+template PackedTrack<vec3> pack_track(const Track<vec3>& track);
+template PackedTrack<quat> pack_track(const Track<quat>& track);
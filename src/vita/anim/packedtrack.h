@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+
+#include "vita/anim/track.h"
+
+/// a track with the keys stored as separate arrays, the time search only touches the times and
+/// linear and constant tracks never store or load the tangents
+template<typename T>
+struct PackedTrack
+{
+	std::vector<float> times;
+	std::vector<T> values;
+
+	/// only used by cubic tracks, empty otherwise
+	std::vector<T> in_tangents;
+	std::vector<T> out_tangents;
+
+	Interpolation interpolation;
+
+	PackedTrack(const std::vector<Frame<T>>& fra, Interpolation in);
+
+	/// resize all arrays, the tangents are only allocated for cubic tracks
+	void resize(std::size_t number_of_frames);
+	std::size_t size() const;
+
+	bool is_valid() const;
+
+	float get_start_time() const;
+	float get_end_time() const;
+	T get_sample(float time, bool looping) const;
+	T get_sample(float time, bool looping, TrackCursor& cursor) const;
+
+	/// loop or clamp the time to the track, the result is the track time used by the functions
+	/// below
+	float adjust_time_to_fit(float time, bool looping) const;
+
+	/// the frame before the track time
+	int get_frame_index(float track_time, bool looping) const;
+
+	/// sample using a frame index found by some external lookup
+	T get_sample_at_frame(int frame_index, float track_time) const;
+};
+
+typedef PackedTrack<float> PackedScalarTrack;
+typedef PackedTrack<vec3> PackedVectorTrack;
+typedef PackedTrack<quat> PackedQuaternionTrack;
+
+template<typename T>
+PackedTrack<T> pack_track(const Track<T>& track);
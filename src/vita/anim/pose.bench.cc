@@ -0,0 +1,69 @@
+#include "vita/bench.h"
+
+#include "vita/assets.h"
+#include "vita/anim/gltfloader.h"
+#include "vita/anim/pose.h"
+#include "vita/anim/soatransform.h"
+
+BENCHMARK("matrix palette woman.gltf")
+{
+	cgltf_data* gltf = load_gltf_file(assets::woman_gltf());
+	const auto rest_pose = get_rest_pose(gltf);
+	free_gltf_file(gltf);
+
+	auto sorted_pose = rest_pose;
+	remap_joints(sorted_pose, calc_parent_before_child_order(sorted_pose));
+
+	const auto unsorted = bench::measure(
+		"children before parents",
+		[&]() { bench::use(calc_matrix_palette(rest_pose)[0].xx); }
+	);
+	const auto sorted = bench::measure(
+		"parents before children",
+		[&]() { bench::use(calc_matrix_palette(sorted_pose)[0].xx); }
+	);
+
+	bench::print_speedup("parents before children", unsorted, sorted);
+
+	std::vector<mat4> palette;
+	const auto reused = bench::measure(
+		"parents before children, reused palette",
+		[&]()
+		{
+			calc_matrix_palette(sorted_pose, palette);
+			bench::use(palette[0].xx);
+		}
+	);
+
+	SoaTransforms locals;
+	const auto batched = bench::measure(
+		"parents before children, batched",
+		[&]()
+		{
+			calc_matrix_palette(sorted_pose, locals, palette);
+			bench::use(palette[0].xx);
+		}
+	);
+	bench::print_speedup("parents before children, batched", reused, batched);
+
+	std::vector<affine3x4> affines;
+	const auto affine = bench::measure(
+		"parents before children, affine3x4",
+		[&]()
+		{
+			calc_affine_palette(sorted_pose, affines);
+			bench::use(affines[0].xx);
+		}
+	);
+	bench::print_speedup("parents before children, affine3x4", reused, affine);
+
+	const auto batched_affine = bench::measure(
+		"parents before children, batched affine3x4",
+		[&]()
+		{
+			calc_affine_palette(sorted_pose, locals, affines);
+			bench::use(affines[0].xx);
+		}
+	);
+	bench::print_speedup("parents before children, batched affine3x4", reused, batched_affine);
+}
@@ -1,6 +1,10 @@
 #include "vita/anim/pose.h"
 
+#include "vita/assert.h"
+#include "vita/anim/soatransform.h"
+
 #include <cstring>
+#include <limits>
 
 Transform calc_global_transform(const Pose& joints, std::size_t index)
 {
@@ -15,17 +19,196 @@ Transform calc_global_transform(const Pose& joints, std::size_t index)
 }
 
 std::vector<mat4> calc_matrix_palette(const Pose& pose)
+{
+	std::vector<mat4> out;
+	calc_matrix_palette(pose, out);
+	return out;
+}
+
+void calc_matrix_palette(const Pose& pose, std::vector<mat4>& palette)
 {
 	const auto size = pose.size();
+	palette.resize(size);
 
-	std::vector<mat4> out;
-	out.resize(size);
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		const auto parent = pose[i].parent;
+		if (parent.has_value() == false)
+		{
+			palette[i] = mat4_from_transform(pose[i].local);
+		}
+		else if (*parent < i)
+		{
+			// the parent is already in model space
+			palette[i] = palette[*parent] * mat4_from_transform(pose[i].local);
+		}
+		else
+		{
+			palette[i] = mat4_from_transform(calc_global_transform(pose, i));
+		}
+	}
+}
 
+void calc_matrix_palette(const Pose& pose, SoaTransforms& locals, std::vector<mat4>& palette)
+{
+	const auto size = pose.size();
+	locals.resize(size);
 	for (std::size_t i = 0; i < size; ++i)
 	{
-		Transform t = calc_global_transform(pose, i);
-		out[i] = mat4_from_transform(t);
+		locals.set(i, pose[i].local);
 	}
+	soa_transform::to_mat4(locals, palette);
 
-	return out;
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		const auto parent = pose[i].parent;
+		if (parent.has_value() == false)
+		{
+			continue;
+		}
+		else if (*parent < i)
+		{
+			palette[i] = palette[*parent] * palette[i];
+		}
+		else
+		{
+			palette[i] = mat4_from_transform(calc_global_transform(pose, i));
+		}
+	}
+}
+
+void calc_affine_palette(const Pose& pose, std::vector<affine3x4>& palette)
+{
+	const auto size = pose.size();
+	palette.resize(size);
+
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		const auto parent = pose[i].parent;
+		if (parent.has_value() == false)
+		{
+			palette[i] = affine3x4_from_transform(pose[i].local);
+		}
+		else if (*parent < i)
+		{
+			palette[i] = palette[*parent] * affine3x4_from_transform(pose[i].local);
+		}
+		else
+		{
+			palette[i] = affine3x4_from_transform(calc_global_transform(pose, i));
+		}
+	}
+}
+
+void calc_affine_palette(const Pose& pose, SoaTransforms& locals, std::vector<affine3x4>& palette)
+{
+	const auto size = pose.size();
+	locals.resize(size);
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		locals.set(i, pose[i].local);
+	}
+	soa_transform::to_affine3x4(locals, palette);
+
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		const auto parent = pose[i].parent;
+		if (parent.has_value() == false)
+		{
+			continue;
+		}
+		else if (*parent < i)
+		{
+			palette[i] = palette[*parent] * palette[i];
+		}
+		else
+		{
+			palette[i] = affine3x4_from_transform(calc_global_transform(pose, i));
+		}
+	}
+}
+
+void calc_dual_quaternion_palette(const Pose& pose, std::vector<DualQuaternion>& palette)
+{
+	const auto size = pose.size();
+	palette.resize(size);
+
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		const auto parent = pose[i].parent;
+		if (parent.has_value() == false)
+		{
+			palette[i] = dual_quaternion_from_transform(pose[i].local);
+		}
+		else if (*parent < i)
+		{
+			palette[i] = dual_quaternion_from_transform(pose[i].local) * palette[*parent];
+		}
+		else
+		{
+			palette[i] = dual_quaternion_from_transform(calc_global_transform(pose, i));
+		}
+	}
+}
+
+bool is_parent_before_child(const Pose& pose)
+{
+	for (std::size_t i = 0; i < pose.size(); ++i)
+	{
+		if (pose[i].parent.has_value() && *pose[i].parent >= i)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+JointOrder calc_parent_before_child_order(const Pose& pose)
+{
+	constexpr auto NOT_PLACED = std::numeric_limits<std::size_t>::max();
+
+	const auto size = pose.size();
+
+	JointOrder order;
+	order.new_index.resize(size, NOT_PLACED);
+	order.old_index.reserve(size);
+
+	std::vector<std::size_t> chain;
+	for (std::size_t joint = 0; joint < size; ++joint)
+	{
+		// place the parents that aren't placed yet first, root most first
+		chain.clear();
+		for (std::optional<std::size_t> current = joint;
+			 current.has_value() && order.new_index[*current] == NOT_PLACED;
+			 current = pose[*current].parent)
+		{
+			// the joint hierarchy has a cycle
+			ASSERT(chain.size() < size);
+			chain.emplace_back(*current);
+		}
+
+		for (auto placed = chain.rbegin(); placed != chain.rend(); ++placed)
+		{
+			order.new_index[*placed] = order.old_index.size();
+			order.old_index.emplace_back(*placed);
+		}
+	}
+
+	return order;
+}
+
+void remap_joints(Pose& pose, const JointOrder& order)
+{
+	ASSERT(pose.size() == order.old_index.size());
+
+	auto old_pose = pose;
+	for (std::size_t joint = 0; joint < pose.size(); ++joint)
+	{
+		auto& moved = pose[joint];
+		moved = old_pose[order.old_index[joint]];
+		if (moved.parent)
+		{
+			moved.parent = order.new_index[*moved.parent];
+		}
+	}
 }
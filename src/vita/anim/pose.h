@@ -3,7 +3,11 @@
 #include <vector>
 #include <optional>
 
+#include "vita/anim/affine3x4.h"
 #include "vita/anim/transform.h"
+#include "vita/anim/dualquaternion.h"
+
+struct SoaTransforms;
 
 // why is parent part of the Pose/joint???
 
@@ -17,5 +21,38 @@ using Pose = std::vector<Joint>;
 
 Transform calc_global_transform(const Pose& pose, std::size_t index);
 
-/// this seems what we used to called a compile pose
+/// this seems what we used to called a compile pose, linear in the number of joints if the parents
+/// come before their children, otherwise every out of order joint walks to the root
 std::vector<mat4> calc_matrix_palette(const Pose& pose);
+
+/// same as above but reuses the memory of the palette
+void calc_matrix_palette(const Pose& pose, std::vector<mat4>& palette);
+
+/// same as above but all local transforms are converted in one batch first, locals is scratch
+/// memory that can be reused between calls
+void calc_matrix_palette(const Pose& pose, SoaTransforms& locals, std::vector<mat4>& palette);
+
+/// calc_matrix_palette without the constant bottom row of every matrix
+void calc_affine_palette(const Pose& pose, std::vector<affine3x4>& palette);
+void calc_affine_palette(const Pose& pose, SoaTransforms& locals, std::vector<affine3x4>& palette);
+
+/// calc_matrix_palette for dual quaternion skinning, the scale of the joints is lost
+void calc_dual_quaternion_palette(const Pose& pose, std::vector<DualQuaternion>& palette);
+
+/// where every joint goes when the joints are reordered
+struct JointOrder
+{
+	/// indexed by the old joint index
+	std::vector<std::size_t> new_index;
+
+	/// indexed by the new joint index
+	std::vector<std::size_t> old_index;
+};
+
+bool is_parent_before_child(const Pose& pose);
+
+/// an order where every parent comes before its children, joints that already follow their parent
+/// keep their relative order so an already sorted pose gets the identity order
+JointOrder calc_parent_before_child_order(const Pose& pose);
+
+void remap_joints(Pose& pose, const JointOrder& order);
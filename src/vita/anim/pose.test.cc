@@ -0,0 +1,96 @@
+#include "catch.hpp"
+
+#include "vita/anim/clip.h"
+#include "vita/anim/pose.h"
+#include "vita/anim/soatransform.h"
+
+#include <cmath>
+
+namespace
+{
+bool is_close(const mat4& lhs, const mat4& rhs)
+{
+	for (int i = 0; i < 16; i += 1)
+	{
+		if (std::abs(lhs[i] - rhs[i]) > 0.0001f)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+Joint make_joint(std::optional<std::size_t> parent, float offset)
+{
+	Joint joint;
+	joint.parent = parent;
+	joint.local.position = vec3(offset, 1.0f, 0.0f);
+	joint.local.rotation = quat_from_angle_axis(offset, vec3(0.0f, 0.0f, 1.0f));
+	joint.local.scale = vec3(1.5f, 1.5f, 1.5f);
+	return joint;
+}
+}  //  namespace
+
+TEST_CASE("pose parent before child order")
+{
+	// 4 -> 2 -> 0 and 4 -> 1 -> 3, children listed before their parents
+	Pose pose;
+	pose.emplace_back(make_joint(2, 0.1f));
+	pose.emplace_back(make_joint(4, 0.2f));
+	pose.emplace_back(make_joint(4, 0.3f));
+	pose.emplace_back(make_joint(1, 0.4f));
+	pose.emplace_back(make_joint(std::nullopt, 0.5f));
+	CHECK_FALSE(is_parent_before_child(pose));
+
+	const auto order = calc_parent_before_child_order(pose);
+	auto sorted = pose;
+	remap_joints(sorted, order);
+	CHECK(is_parent_before_child(sorted));
+
+	const auto identity = calc_parent_before_child_order(sorted);
+	for (std::size_t joint = 0; joint < sorted.size(); joint += 1)
+	{
+		CHECK(identity.new_index[joint] == joint);
+		CHECK(order.old_index[order.new_index[joint]] == joint);
+	}
+
+	// the linear and the walk to the root palettes match
+	const auto palette = calc_matrix_palette(pose);
+	const auto sorted_palette = calc_matrix_palette(sorted);
+	SoaTransforms locals;
+	std::vector<mat4> batched_palette;
+	std::vector<mat4> sorted_batched_palette;
+	calc_matrix_palette(pose, locals, batched_palette);
+	calc_matrix_palette(sorted, locals, sorted_batched_palette);
+	std::vector<affine3x4> affine_palette;
+	std::vector<affine3x4> batched_affine_palette;
+	calc_affine_palette(pose, affine_palette);
+	calc_affine_palette(pose, locals, batched_affine_palette);
+	for (std::size_t joint = 0; joint < pose.size(); joint += 1)
+	{
+		const auto expected = mat4_from_transform(calc_global_transform(pose, joint));
+		CHECK(is_close(palette[joint], expected));
+		CHECK(is_close(sorted_palette[order.new_index[joint]], expected));
+		CHECK(is_close(batched_palette[joint], expected));
+		CHECK(is_close(sorted_batched_palette[order.new_index[joint]], expected));
+		CHECK(is_close(mat4_from_affine3x4(affine_palette[joint]), expected));
+		CHECK(is_close(mat4_from_affine3x4(batched_affine_palette[joint]), expected));
+	}
+
+	std::vector<Frame<vec3>> frames;
+	frames.emplace_back(0.0f, vec3(), vec3(), vec3(1.0f, 2.0f, 3.0f));
+	frames.emplace_back(1.0f, vec3(), vec3(), vec3(1.0f, 2.0f, 3.0f));
+
+	Clip clip;
+	clip[0].position.frames = frames;
+	clip[4].position.frames = frames;
+	clip.duration = duration_from_tracks(clip.tracks);
+	remap_joints(clip, order);
+	CHECK(clip.tracks[0].id == order.new_index[4]);
+	CHECK(clip.tracks[1].id == order.new_index[0]);
+
+	auto sampled = sorted;
+	clip.sample_to_pose(sampled, 0.5f);
+	CHECK(sampled[order.new_index[0]].local.position == vec3(1.0f, 2.0f, 3.0f));
+	CHECK(sampled[order.new_index[2]].local.position == sorted[order.new_index[2]].local.position);
+}
@@ -0,0 +1,102 @@
+#include "vita/anim/posebatch.h"
+
+#include "vita/assert.h"
+
+#include <algorithm>
+
+template<typename CLIP>
+void PoseBatch<CLIP>::prepare(
+	const std::vector<CLIP>& all_clips, const std::vector<ClipInstance>& all_instances
+)
+{
+	clips = &all_clips;
+
+	const auto number_of_clips = all_clips.size();
+	const auto number_of_instances = all_instances.size();
+
+	// counting sort on the clip index
+	clip_offsets.assign(number_of_clips + 1, 0);
+	times.resize(number_of_instances);
+	for (std::size_t instance = 0; instance < number_of_instances; ++instance)
+	{
+		const auto& request = all_instances[instance];
+		ASSERT(request.clip < number_of_clips);
+		clip_offsets[request.clip + 1] += 1;
+		times[instance] = all_clips[request.clip].adjust_time_to_fit(request.time);
+	}
+	for (std::size_t clip = 0; clip < number_of_clips; ++clip)
+	{
+		clip_offsets[clip + 1] += clip_offsets[clip];
+	}
+
+	instances.resize(number_of_instances);
+	auto next = std::vector<std::size_t>(clip_offsets.begin(), clip_offsets.end() - 1);
+	for (std::size_t instance = 0; instance < number_of_instances; ++instance)
+	{
+		instances[next[all_instances[instance].clip]++] = instance;
+	}
+
+	jobs.clear();
+	for (std::size_t clip = 0; clip < number_of_clips; ++clip)
+	{
+		const auto first = instances.begin() + static_cast<std::ptrdiff_t>(clip_offsets[clip]);
+		const auto last = instances.begin() + static_cast<std::ptrdiff_t>(clip_offsets[clip + 1]);
+
+		// sample_to_pose doesn't sample clips without a duration
+		if (first == last || all_clips[clip].GetDuration() == 0.0f)
+		{
+			continue;
+		}
+
+		// instances close in time read the same keys
+		std::sort(
+			first,
+			last,
+			[this](std::size_t lhs, std::size_t rhs) { return times[lhs] < times[rhs]; }
+		);
+
+		for (std::size_t track = 0; track < all_clips[clip].tracks.size(); ++track)
+		{
+			jobs.emplace_back(PoseBatchJob{clip, track});
+		}
+	}
+}
+
+template<typename CLIP>
+std::size_t PoseBatch<CLIP>::get_number_of_jobs() const
+{
+	return jobs.size();
+}
+
+template<typename CLIP>
+void PoseBatch<CLIP>::run_job(std::size_t job_index, std::vector<Pose>& poses) const
+{
+	const auto& job = jobs[job_index];
+	const auto& clip = (*clips)[job.clip];
+	const auto& track = clip.tracks[job.track];
+	const auto joint = track.id;
+
+	// the instances are sorted by time so the cursor only moves forward a few keys at a time
+	auto cursor = TransformTrackCursor{};
+	for (auto index = clip_offsets[job.clip]; index < clip_offsets[job.clip + 1]; ++index)
+	{
+		const auto instance = instances[index];
+		auto& local = poses[instance][joint].local;
+		local = track.get_sample(local, times[instance], clip.is_looping, cursor);
+	}
+}
+
+template<typename CLIP>
+void PoseBatch<CLIP>::run(std::vector<Pose>& poses) const
+{
+	const auto number_of_jobs = get_number_of_jobs();
+	for (std::size_t job = 0; job < number_of_jobs; ++job)
+	{
+		run_job(job, poses);
+	}
+}
+
+template struct PoseBatch<Clip>;
+template struct PoseBatch<FastClip>;
+template struct PoseBatch<PackedClip>;
+template struct PoseBatch<CompressedClip>;
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+
+#include "vita/anim/clip.h"
+#include "vita/anim/pose.h"
+
+/// one animated instance, the pose with the same index gets the result
+struct ClipInstance
+{
+	std::size_t clip;
+	float time;
+};
+
+/// samples a track for every instance playing a clip
+struct PoseBatchJob
+{
+	std::size_t clip;
+	std::size_t track;
+};
+
+/// samples many instances that share a few clips, the work is grouped by clip and track so the
+/// keys of a track stay in cache while every instance playing it is sampled
+template<typename CLIP>
+struct PoseBatch
+{
+	const std::vector<CLIP>* clips = nullptr;
+
+	/// the clip time of each instance, same as sample_to_pose would return
+	std::vector<float> times;
+
+	/// the instance indices sorted by clip
+	std::vector<std::size_t> instances;
+
+	/// where the instances of each clip starts, one extra at the end
+	std::vector<std::size_t> clip_offsets;
+
+	std::vector<PoseBatchJob> jobs;
+
+	/// group the instances by clip, needs to be called when the instances or times change
+	void prepare(
+		const std::vector<CLIP>& all_clips, const std::vector<ClipInstance>& all_instances
+	);
+
+	std::size_t get_number_of_jobs() const;
+
+	/// the jobs write to different joints so they can run at the same time on different threads,
+	/// the poses need to be the rest pose or a previous sample
+	void run_job(std::size_t job_index, std::vector<Pose>& poses) const;
+
+	/// run all jobs on this thread
+	void run(std::vector<Pose>& poses) const;
+};
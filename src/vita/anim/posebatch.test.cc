@@ -0,0 +1,69 @@
+#include "catch.hpp"
+
+#include "vita/anim/posebatch.h"
+
+namespace
+{
+Clip make_clip(float speed, std::size_t number_of_joints)
+{
+	Clip clip;
+	for (std::size_t joint = 0; joint < number_of_joints; joint += 2)
+	{
+		auto& track = clip[joint];
+		for (int i = 0; i <= 10; i += 1)
+		{
+			const auto time = static_cast<float>(i) * 0.25f;
+			const auto value = (static_cast<float>(i) + static_cast<float>(joint)) * speed;
+			track.position.frames.emplace_back(time, vec3(), vec3(), vec3(value, 0.0f, -value));
+			track.rotation.frames.emplace_back(
+				time, quat(), quat(), quat_from_angle_axis(value, vec3(0.0f, 1.0f, 0.0f))
+			);
+		}
+	}
+	clip.duration = duration_from_tracks(clip.tracks);
+	return clip;
+}
+}  //  namespace
+
+TEST_CASE("pose batch")
+{
+	constexpr std::size_t number_of_joints = 7;
+
+	std::vector<Clip> clips;
+	clips.emplace_back(make_clip(1.0f, number_of_joints));
+	clips.emplace_back(make_clip(-0.5f, number_of_joints));
+	clips.emplace_back(make_clip(2.0f, number_of_joints));
+	clips[1].is_looping = false;
+
+	const auto rest_pose = Pose(number_of_joints);
+
+	std::vector<ClipInstance> instances;
+	for (int i = 0; i < 50; i += 1)
+	{
+		// the last clip isn't played by anyone
+		const auto clip = static_cast<std::size_t>(i % 2);
+		instances.emplace_back(ClipInstance{clip, static_cast<float>(i) * 0.13f});
+	}
+
+	auto batch = PoseBatch<Clip>{};
+	batch.prepare(clips, instances);
+	CHECK(batch.get_number_of_jobs() == clips[0].tracks.size() + clips[1].tracks.size());
+
+	auto poses = std::vector<Pose>(instances.size(), rest_pose);
+	batch.run(poses);
+
+	for (std::size_t instance = 0; instance < instances.size(); instance += 1)
+	{
+		auto expected = rest_pose;
+		const auto& clip = clips[instances[instance].clip];
+		const auto time = clip.sample_to_pose(expected, instances[instance].time);
+		CHECK(time == batch.times[instance]);
+
+		for (std::size_t joint = 0; joint < number_of_joints; joint += 1)
+		{
+			CHECK(expected[joint].local.position == poses[instance][joint].local.position);
+			CHECK(expected[joint].local.rotation == poses[instance][joint].local.rotation);
+			CHECK(expected[joint].local.scale == poses[instance][joint].local.scale);
+		}
+	}
+}
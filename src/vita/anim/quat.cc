@@ -2,37 +2,6 @@
 #include <cmath>
 #include <iostream>
 
-const float* quat::data_ptr() const
-{
-	return &x;
-}
-
-quat::quat()
-	: x(0)
-	, y(0)
-	, z(0)
-	, w(1)
-{
-}
-
-quat::quat(float _x, float _y, float _z, float _w)
-	: x(_x)
-	, y(_y)
-	, z(_z)
-	, w(_w)
-{
-}
-
-vec3 quat::vector() const
-{
-	return {x, y, z};
-}
-
-float quat::scalar() const
-{
-	return w;
-}
-
 vec3 quat::get_axis() const
 {
 	return get_normalized(vec3(x, y, z));
@@ -81,39 +50,6 @@ quat quat_from_rotation(const vec3& from, const vec3& to)
 	return quat(axis.x, axis.y, axis.z, dot(f, half));
 }
 
-quat operator+(const quat& a, const quat& b)
-{
-	return quat(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w);
-}
-
-quat operator-(const quat& a, const quat& b)
-{
-	return quat(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w);
-}
-
-quat operator*(const quat& a, float b)
-{
-	return quat(a.x * b, a.y * b, a.z * b, a.w * b);
-}
-
-quat operator-(const quat& q)
-{
-	return quat(-q.x, -q.y, -q.z, -q.w);
-}
-
-bool operator==(const quat& left, const quat& right)
-{
-	return (
-		fabsf(left.x - right.x) <= QUAT_EPSILON && fabsf(left.y - right.y) <= QUAT_EPSILON
-		&& fabsf(left.z - right.z) <= QUAT_EPSILON && fabsf(left.w - right.w) <= QUAT_EPSILON
-	);
-}
-
-bool operator!=(const quat& a, const quat& b)
-{
-	return ! (a == b);
-}
-
 bool is_same_orientation(const quat& left, const quat& right)
 {
 	return (fabsf(left.x - right.x) <= QUAT_EPSILON && fabsf(left.y - right.y) <= QUAT_EPSILON
@@ -122,96 +58,16 @@ bool is_same_orientation(const quat& left, const quat& right)
 			&& fabsf(left.z + right.z) <= QUAT_EPSILON && fabsf(left.w + right.w) <= QUAT_EPSILON);
 }
 
-float dot(const quat& a, const quat& b)
+float get_angle_between(const quat& left, const quat& right)
 {
-	return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
-}
+	const auto a = get_normalized(left);
+	const auto b = get_normalized(right);
 
-float get_length_sq(const quat& q)
-{
-	return q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w;
-}
-
-float get_length(const quat& q)
-{
-	const auto lenSq = q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w;
-	if (lenSq < QUAT_EPSILON)
-	{
-		return 0.0f;
-	}
-	return sqrtf(lenSq);
-}
-
-void normalize(quat& q)
-{
-	const auto lenSq = q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w;
-	if (lenSq < QUAT_EPSILON)
-	{
-		return;
-	}
-	const auto i_len = 1.0f / sqrtf(lenSq);
-
-	q.x *= i_len;
-	q.y *= i_len;
-	q.z *= i_len;
-	q.w *= i_len;
-}
-
-quat get_normalized(const quat& q)
-{
-	const auto lenSq = q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w;
-	if (lenSq < QUAT_EPSILON)
-	{
-		return quat();
-	}
-	const auto i_len = 1.0f / sqrtf(lenSq);
-
-	return quat(q.x * i_len, q.y * i_len, q.z * i_len, q.w * i_len);
-}
-
-quat get_conjugate(const quat& q)
-{
-	return quat(-q.x, -q.y, -q.z, q.w);
-}
-
-quat get_inverse(const quat& q)
-{
-	const auto lenSq = q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w;
-	if (lenSq < QUAT_EPSILON)
-	{
-		return quat();
-	}
-	float recip = 1.0f / lenSq;
-
-	// conjugate / norm
-	return quat(-q.x * recip, -q.y * recip, -q.z * recip, q.w * recip);
-}
-
-quat operator*(const quat& Q1, const quat& Q2)
-{
-	return quat(
-		Q2.x * Q1.w + Q2.y * Q1.z - Q2.z * Q1.y + Q2.w * Q1.x,
-		-Q2.x * Q1.z + Q2.y * Q1.w + Q2.z * Q1.x + Q2.w * Q1.y,
-		Q2.x * Q1.y - Q2.y * Q1.x + Q2.z * Q1.w + Q2.w * Q1.z,
-		-Q2.x * Q1.x - Q2.y * Q1.y - Q2.z * Q1.z + Q2.w * Q1.w
-	);
-}
-
-vec3 operator*(const quat& q, const vec3& v)
-{
-	return q.vector() * 2.0f * dot(q.vector(), v)
-		 + v * (q.scalar() * q.scalar() - dot(q.vector(), q.vector()))
-		 + cross(q.vector(), v) * 2.0f * q.scalar();
-}
-
-quat lerp(const quat& from, const quat& to, float t)
-{
-	return from * (1.0f - t) + to * t;
-}
-
-quat nlerp(const quat& from, const quat& to, float t)
-{
-	return get_normalized(lerp(from, to, t));
+	// the length of the difference is 2 sin(angle/4), unlike acos of the dot it doesn't lose
+	// precision for small angles
+	const auto difference = dot(a, b) < 0.0f ? a + b : a - b;
+	const auto half_length = sqrtf(get_length_sq(difference)) * 0.5f;
+	return 4.0f * asinf(half_length < 1.0f ? half_length : 1.0f);
 }
 
 quat operator^(const quat& q, float f)
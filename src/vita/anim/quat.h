@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cassert>
+#include <cmath>
+#include <cstddef>
 
 #include "vita/anim/vec3.h"
 #include "vita/anim/mat4.h"
@@ -30,13 +32,36 @@ struct quat
 		}
 	}
 
-	quat();
-	quat(float _x, float _y, float _z, float _w);
+	constexpr quat()
+		: x(0)
+		, y(0)
+		, z(0)
+		, w(1)
+	{
+	}
+
+	constexpr quat(float _x, float _y, float _z, float _w)
+		: x(_x)
+		, y(_y)
+		, z(_z)
+		, w(_w)
+	{
+	}
+
+	constexpr const float* data_ptr() const
+	{
+		return &x;
+	}
 
-	const float* data_ptr() const;
+	constexpr vec3 vector() const
+	{
+		return {x, y, z};
+	}
 
-	vec3 vector() const;
-	float scalar() const;
+	constexpr float scalar() const
+	{
+		return w;
+	}
 
 	vec3 get_axis() const;
 	float get_angle() const;
@@ -45,30 +70,138 @@ struct quat
 #pragma pack(pop)
 static_assert(sizeof(quat) == sizeof(float) * 4, "Invalid size");
 
-quat operator+(const quat& a, const quat& b);
-quat operator-(const quat& a, const quat& b);
-quat operator*(const quat& a, float b);
-quat operator-(const quat& q);
-bool operator==(const quat& left, const quat& right);
-bool operator!=(const quat& a, const quat& b);
-quat operator*(const quat& Q1, const quat& Q2);
-quat operator*(const quat& Q1, const quat& Q2);
-vec3 operator*(const quat& q, const vec3& v);
+constexpr quat operator+(const quat& a, const quat& b)
+{
+	return quat(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w);
+}
+
+constexpr quat operator-(const quat& a, const quat& b)
+{
+	return quat(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w);
+}
+
+constexpr quat operator*(const quat& a, float b)
+{
+	return quat(a.x * b, a.y * b, a.z * b, a.w * b);
+}
+
+constexpr quat operator-(const quat& q)
+{
+	return quat(-q.x, -q.y, -q.z, -q.w);
+}
+
+inline bool operator==(const quat& left, const quat& right)
+{
+	return (
+		fabsf(left.x - right.x) <= QUAT_EPSILON && fabsf(left.y - right.y) <= QUAT_EPSILON
+		&& fabsf(left.z - right.z) <= QUAT_EPSILON && fabsf(left.w - right.w) <= QUAT_EPSILON
+	);
+}
+
+inline bool operator!=(const quat& a, const quat& b)
+{
+	return ! (a == b);
+}
+
+constexpr quat operator*(const quat& Q1, const quat& Q2)
+{
+	return quat(
+		Q2.x * Q1.w + Q2.y * Q1.z - Q2.z * Q1.y + Q2.w * Q1.x,
+		-Q2.x * Q1.z + Q2.y * Q1.w + Q2.z * Q1.x + Q2.w * Q1.y,
+		Q2.x * Q1.y - Q2.y * Q1.x + Q2.z * Q1.w + Q2.w * Q1.z,
+		-Q2.x * Q1.x - Q2.y * Q1.y - Q2.z * Q1.z + Q2.w * Q1.w
+	);
+}
+
+constexpr vec3 operator*(const quat& q, const vec3& v)
+{
+	return q.vector() * 2.0f * dot(q.vector(), v)
+		 + v * (q.scalar() * q.scalar() - dot(q.vector(), q.vector()))
+		 + cross(q.vector(), v) * 2.0f * q.scalar();
+}
+
 quat operator^(const quat& q, float f);
 
 bool is_same_orientation(const quat& left, const quat& right);
 
-float get_length_sq(const quat& q);
-float get_length(const quat& q);
-quat get_normalized(const quat& q);
-quat get_conjugate(const quat& q);
-quat get_inverse(const quat& q);
+/// the angle between two orientations in radians, precise for small angles
+float get_angle_between(const quat& left, const quat& right);
 
-void normalize(quat& q);
+constexpr float dot(const quat& a, const quat& b)
+{
+	return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+}
+
+constexpr float get_length_sq(const quat& q)
+{
+	return q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w;
+}
+
+inline float get_length(const quat& q)
+{
+	const auto lenSq = get_length_sq(q);
+	if (lenSq < QUAT_EPSILON)
+	{
+		return 0.0f;
+	}
+	return sqrtf(lenSq);
+}
+
+inline void normalize(quat& q)
+{
+	const auto lenSq = get_length_sq(q);
+	if (lenSq < QUAT_EPSILON)
+	{
+		return;
+	}
+	const auto i_len = 1.0f / sqrtf(lenSq);
+
+	q.x *= i_len;
+	q.y *= i_len;
+	q.z *= i_len;
+	q.w *= i_len;
+}
+
+inline quat get_normalized(const quat& q)
+{
+	const auto lenSq = get_length_sq(q);
+	if (lenSq < QUAT_EPSILON)
+	{
+		return quat();
+	}
+	const auto i_len = 1.0f / sqrtf(lenSq);
+
+	return quat(q.x * i_len, q.y * i_len, q.z * i_len, q.w * i_len);
+}
+
+constexpr quat get_conjugate(const quat& q)
+{
+	return quat(-q.x, -q.y, -q.z, q.w);
+}
+
+constexpr quat get_inverse(const quat& q)
+{
+	const auto lenSq = get_length_sq(q);
+	if (lenSq < QUAT_EPSILON)
+	{
+		return quat();
+	}
+	const auto recip = 1.0f / lenSq;
+
+	// conjugate / norm
+	return quat(-q.x * recip, -q.y * recip, -q.z * recip, q.w * recip);
+}
+
+constexpr quat lerp(const quat& from, const quat& to, float t)
+{
+	return from * (1.0f - t) + to * t;
+}
+
+inline quat nlerp(const quat& from, const quat& to, float t)
+{
+	return get_normalized(lerp(from, to, t));
+}
 
-quat lerp(const quat& from, const quat& to, float t);
-float dot(const quat& a, const quat& b);
-quat nlerp(const quat& from, const quat& to, float t);
 quat slerp(const quat& start, const quat& end, float t);
 
 quat quat_from_look_rotation(const vec3& direcion, const vec3& up);
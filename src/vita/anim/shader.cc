@@ -1,9 +1,12 @@
 #include "vita/anim/shader.h"
 
+#include "vita/glstate.h"
+
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <cstring>
+#include <utility>
 
 constexpr std::ptrdiff_t STRING_LENGTH = 128;
 constexpr std::ptrdiff_t LONG_STRING_LENGTH = 256;
@@ -22,7 +25,30 @@ Shader::Shader(const ShaderSource& vertex, const ShaderSource& fragment)
 
 Shader::~Shader()
 {
-	glDeleteProgram(handle);
+	if (handle != 0)
+	{
+		glstate::invalidate();
+		glDeleteProgram(handle);
+	}
+}
+
+Shader::Shader(Shader&& other) noexcept
+	: handle(std::exchange(other.handle, 0))
+	, attributes(std::move(other.attributes))
+	, uniforms(std::move(other.uniforms))
+{
+}
+
+Shader& Shader::operator=(Shader&& other) noexcept
+{
+	if (this != &other)
+	{
+		Shader old{std::move(*this)};
+		handle = std::exchange(other.handle, 0);
+		attributes = std::move(other.attributes);
+		uniforms = std::move(other.uniforms);
+	}
+	return *this;
 }
 
 ShaderSource read_shader_file(const std::string& path)
@@ -111,7 +137,7 @@ std::unordered_map<std::string, unsigned int> PopulateAttributes(Shader* shader)
 
 	std::unordered_map<std::string, unsigned int> attributes;
 
-	glUseProgram(shader->handle);
+	glstate::use_program(shader->handle);
 	glGetProgramiv(shader->handle, GL_ACTIVE_ATTRIBUTES, &count);
 
 	for (int i = 0; i < count; ++i)
@@ -127,7 +153,7 @@ std::unordered_map<std::string, unsigned int> PopulateAttributes(Shader* shader)
 		}
 	}
 
-	glUseProgram(0);
+	glstate::use_program(0);
 
 	return attributes;
 }
@@ -142,7 +168,7 @@ std::unordered_map<std::string, int> PopulateUniforms(Shader* shader)
 	char testName[LONG_STRING_LENGTH];
 	std::unordered_map<std::string, int> uniforms;
 
-	glUseProgram(shader->handle);
+	glstate::use_program(shader->handle);
 	glGetProgramiv(shader->handle, GL_ACTIVE_UNIFORMS, &count);
 
 	for (int i = 0; i < count; ++i)
@@ -180,7 +206,7 @@ std::unordered_map<std::string, int> PopulateUniforms(Shader* shader)
 		}
 	}
 
-	glUseProgram(0);
+	glstate::use_program(0);
 
 	return uniforms;
 }
@@ -198,12 +224,12 @@ void Shader::Load(const ShaderSource& vertex, const ShaderSource& fragment)
 
 void Shader::bind()
 {
-	glUseProgram(handle);
+	glstate::use_program(handle);
 }
 
 void Shader::unbind()
 {
-	glUseProgram(0);
+	// left bound, the next bind replaces it and binding it again is free
 }
 
 unsigned int Shader::get_attribute(const std::string& name)
@@ -229,3 +255,14 @@ int Shader::get_uniform(const std::string& name)
 	}
 	return it->second;
 }
+
+void Shader::bind_uniform_block(const std::string& name, unsigned int binding)
+{
+	const auto index = glGetUniformBlockIndex(handle, name.c_str());
+	if (index == GL_INVALID_INDEX)
+	{
+		std::cout << "Retrieving bad uniform block: " << name << "\n";
+		return;
+	}
+	glUniformBlockBinding(handle, index, binding);
+}
@@ -13,11 +13,10 @@ struct Shader
 	std::unordered_map<std::string, unsigned int> attributes;
 	std::unordered_map<std::string, int> uniforms;
 
-	Shader(Shader&&) = delete;
-	void operator=(Shader&&) = delete;
+	Shader(Shader&& other) noexcept;
+	Shader& operator=(Shader&& other) noexcept;
 	Shader(const Shader&) = delete;
 	void operator=(const Shader&) = delete;
-	Shader(Shader&) = delete;
 
 	Shader();
 	Shader(const ShaderSource& vertex, const ShaderSource& fragment);
@@ -30,4 +29,7 @@ struct Shader
 
 	unsigned int get_attribute(const std::string& name);
 	int get_uniform(const std::string& name);
+
+	/// read the uniform block from the buffer bound to the binding point
+	void bind_uniform_block(const std::string& name, unsigned int binding);
 };
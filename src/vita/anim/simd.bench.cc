@@ -0,0 +1,166 @@
+#include "vita/bench.h"
+
+#include "vita/cpu.h"
+#include "vita/anim/simd.h"
+#include "vita/anim/transform.h"
+
+#include <cmath>
+
+namespace
+{
+constexpr std::size_t COUNT = 1024;
+
+struct Data
+{
+	std::vector<mat4> matrices;
+	std::vector<quat> rotations;
+	std::vector<vec4> points;
+
+	cpu::CacheAlignedVector<simd::mat4> simd_matrices;
+	cpu::CacheAlignedVector<simd::quat> simd_rotations;
+	cpu::CacheAlignedVector<simd::vec4> simd_points;
+};
+
+Data make_data()
+{
+	Data data;
+	for (std::size_t index = 0; index < COUNT; ++index)
+	{
+		const auto f = static_cast<float>(index);
+		const auto rotation
+			= quat_from_angle_axis(0.01f * f, get_normalized(vec3(std::sin(f), 1.0f, std::cos(f))));
+		const auto transform = Transform(vec3(f, -0.5f * f, 2.0f), rotation, vec3(1, 1.5f, 1));
+
+		data.matrices.emplace_back(mat4_from_transform(transform));
+		data.rotations.emplace_back(rotation);
+		data.points.emplace_back(std::sin(f), 0.01f * f, std::cos(f), 1.0f);
+
+		data.simd_matrices.emplace_back(simd::to_simd(data.matrices.back()));
+		data.simd_rotations.emplace_back(simd::to_simd(rotation));
+		data.simd_points.emplace_back(simd::to_simd(data.points.back()));
+	}
+	return data;
+}
+
+/// run a packed and a simd version of the same operation over all the data
+template<typename PackedFunction, typename SimdFunction>
+void compare(const char* name, PackedFunction packed, SimdFunction simd)
+{
+	const auto baseline = bench::measure(std::string{name} + " packed", packed);
+	const auto measured = bench::measure(std::string{name} + " simd", simd);
+	bench::print_speedup(std::string{name} + " simd", baseline, measured);
+}
+}  //  namespace
+
+BENCHMARK("simd math 1024 elements")
+{
+	const auto data = make_data();
+	std::vector<mat4> matrices(COUNT);
+	std::vector<quat> rotations(COUNT);
+	std::vector<vec4> points(COUNT);
+	std::vector<vec3> vectors(COUNT);
+	cpu::CacheAlignedVector<simd::mat4> simd_matrices(COUNT);
+	cpu::CacheAlignedVector<simd::quat> simd_rotations(COUNT);
+	cpu::CacheAlignedVector<simd::vec4> simd_points(COUNT);
+
+	compare(
+		"mat4 * mat4",
+		[&]()
+		{
+			for (std::size_t i = 0; i + 1 < COUNT; ++i)
+			{
+				matrices[i] = data.matrices[i] * data.matrices[i + 1];
+			}
+			bench::use(matrices[0].xx);
+		},
+		[&]()
+		{
+			for (std::size_t i = 0; i + 1 < COUNT; ++i)
+			{
+				simd_matrices[i] = data.simd_matrices[i] * data.simd_matrices[i + 1];
+			}
+			bench::use(simd_matrices[0].data_ptr()[0]);
+		}
+	);
+
+	compare(
+		"mat4 * vec4",
+		[&]()
+		{
+			for (std::size_t i = 0; i < COUNT; ++i)
+			{
+				points[i] = data.matrices[i] * data.points[i];
+			}
+			bench::use(points[0].x);
+		},
+		[&]()
+		{
+			for (std::size_t i = 0; i < COUNT; ++i)
+			{
+				simd_points[i] = data.simd_matrices[i] * data.simd_points[i];
+			}
+			bench::use(simd::get_lane(simd_points[0], 0));
+		}
+	);
+
+	compare(
+		"mat4 inverse",
+		[&]()
+		{
+			for (std::size_t i = 0; i < COUNT; ++i)
+			{
+				matrices[i] = get_inverse(data.matrices[i]);
+			}
+			bench::use(matrices[0].xx);
+		},
+		[&]()
+		{
+			for (std::size_t i = 0; i < COUNT; ++i)
+			{
+				simd_matrices[i] = simd::get_inverse(data.simd_matrices[i]);
+			}
+			bench::use(simd_matrices[0].data_ptr()[0]);
+		}
+	);
+
+	compare(
+		"quat * quat",
+		[&]()
+		{
+			for (std::size_t i = 0; i + 1 < COUNT; ++i)
+			{
+				rotations[i] = data.rotations[i] * data.rotations[i + 1];
+			}
+			bench::use(rotations[0].x);
+		},
+		[&]()
+		{
+			for (std::size_t i = 0; i + 1 < COUNT; ++i)
+			{
+				simd_rotations[i] = data.simd_rotations[i] * data.simd_rotations[i + 1];
+			}
+			bench::use(simd::get_lane(simd_rotations[0].v, 0));
+		}
+	);
+
+	compare(
+		"quat * vec3",
+		[&]()
+		{
+			for (std::size_t i = 0; i < COUNT; ++i)
+			{
+				const auto& p = data.points[i];
+				vectors[i] = data.rotations[i] * vec3(p.x, p.y, p.z);
+			}
+			bench::use(vectors[0].x);
+		},
+		[&]()
+		{
+			for (std::size_t i = 0; i < COUNT; ++i)
+			{
+				simd_points[i] = data.simd_rotations[i] * data.simd_points[i];
+			}
+			bench::use(simd::get_lane(simd_points[0], 0));
+		}
+	);
+}
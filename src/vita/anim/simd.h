@@ -0,0 +1,407 @@
+#pragma once
+
+#include "vita/cpu.h"
+#include "vita/anim/mat4.h"
+#include "vita/anim/quat.h"
+#include "vita/anim/vec3.h"
+#include "vita/anim/vec4.h"
+
+/// the backend the simd math is compiled for, sse is part of x86-64 so no runtime check is needed
+#if VITA_X86
+	#define VITA_SIMD_SSE 1
+	#define VITA_SIMD_NEON 0
+	#include <xmmintrin.h>
+#elif defined(__ARM_NEON)
+	#define VITA_SIMD_SSE 0
+	#define VITA_SIMD_NEON 1
+	#include <arm_neon.h>
+#else
+	#define VITA_SIMD_SSE 0
+	#define VITA_SIMD_NEON 0
+#endif
+
+/// 16 byte aligned versions of the math types for hot loops, the packed types are still what the
+/// rest of the code and GL uploads use, convert with to_simd and to_packed
+namespace simd
+{
+#if VITA_SIMD_SSE
+using native = __m128;
+#elif VITA_SIMD_NEON
+using native = float32x4_t;
+#else
+struct native
+{
+	float lanes[4];
+};
+#endif
+
+/// four floats in a register, also used for vec3 with w as 0
+struct alignas(16) vec4
+{
+	native v;
+};
+
+/// column major like ::mat4 and with the same layout, so an array of them can be uploaded as is
+struct alignas(16) mat4
+{
+	vec4 columns[4];
+
+	const float* data_ptr() const
+	{
+		return reinterpret_cast<const float*>(columns);
+	}
+};
+
+struct alignas(16) quat
+{
+	vec4 v;
+};
+
+static_assert(sizeof(vec4) == sizeof(::vec4), "Invalid size");
+static_assert(sizeof(mat4) == sizeof(::mat4), "Invalid size");
+static_assert(sizeof(quat) == sizeof(::quat), "Invalid size");
+
+////////////////////////////////////////////////////////////////////////////////
+// the backend specific part, everything after is written in terms of these
+
+inline vec4 make_vec4(float x, float y, float z, float w)
+{
+#if VITA_SIMD_SSE
+	return {_mm_setr_ps(x, y, z, w)};
+#elif VITA_SIMD_NEON
+	const float lanes[4] = {x, y, z, w};
+	return {vld1q_f32(lanes)};
+#else
+	return {{{x, y, z, w}}};
+#endif
+}
+
+inline vec4 splat(float f)
+{
+#if VITA_SIMD_SSE
+	return {_mm_set1_ps(f)};
+#elif VITA_SIMD_NEON
+	return {vdupq_n_f32(f)};
+#else
+	return {{{f, f, f, f}}};
+#endif
+}
+
+/// the source doesn't need to be aligned
+inline vec4 load(const float* source)
+{
+#if VITA_SIMD_SSE
+	return {_mm_loadu_ps(source)};
+#elif VITA_SIMD_NEON
+	return {vld1q_f32(source)};
+#else
+	return {{{source[0], source[1], source[2], source[3]}}};
+#endif
+}
+
+/// the target doesn't need to be aligned
+inline void store(float* target, const vec4& a)
+{
+#if VITA_SIMD_SSE
+	_mm_storeu_ps(target, a.v);
+#elif VITA_SIMD_NEON
+	vst1q_f32(target, a.v);
+#else
+	for (int i = 0; i < 4; ++i)
+	{
+		target[i] = a.v.lanes[i];
+	}
+#endif
+}
+
+inline vec4 operator+(const vec4& a, const vec4& b)
+{
+#if VITA_SIMD_SSE
+	return {_mm_add_ps(a.v, b.v)};
+#elif VITA_SIMD_NEON
+	return {vaddq_f32(a.v, b.v)};
+#else
+	return make_vec4(
+		a.v.lanes[0] + b.v.lanes[0],
+		a.v.lanes[1] + b.v.lanes[1],
+		a.v.lanes[2] + b.v.lanes[2],
+		a.v.lanes[3] + b.v.lanes[3]
+	);
+#endif
+}
+
+inline vec4 operator-(const vec4& a, const vec4& b)
+{
+#if VITA_SIMD_SSE
+	return {_mm_sub_ps(a.v, b.v)};
+#elif VITA_SIMD_NEON
+	return {vsubq_f32(a.v, b.v)};
+#else
+	return make_vec4(
+		a.v.lanes[0] - b.v.lanes[0],
+		a.v.lanes[1] - b.v.lanes[1],
+		a.v.lanes[2] - b.v.lanes[2],
+		a.v.lanes[3] - b.v.lanes[3]
+	);
+#endif
+}
+
+/// component wise
+inline vec4 operator*(const vec4& a, const vec4& b)
+{
+#if VITA_SIMD_SSE
+	return {_mm_mul_ps(a.v, b.v)};
+#elif VITA_SIMD_NEON
+	return {vmulq_f32(a.v, b.v)};
+#else
+	return make_vec4(
+		a.v.lanes[0] * b.v.lanes[0],
+		a.v.lanes[1] * b.v.lanes[1],
+		a.v.lanes[2] * b.v.lanes[2],
+		a.v.lanes[3] * b.v.lanes[3]
+	);
+#endif
+}
+
+inline float get_lane(const vec4& a, int lane)
+{
+	alignas(16) float lanes[4];
+	store(lanes, a);
+	return lanes[lane];
+}
+
+/// (a[X], a[Y], b[Z], b[W]) like _mm_shuffle_ps
+template<int X, int Y, int Z, int W>
+vec4 shuffle(const vec4& a, const vec4& b)
+{
+#if VITA_SIMD_SSE
+	return {_mm_shuffle_ps(a.v, b.v, _MM_SHUFFLE(W, Z, Y, X))};
+#elif VITA_SIMD_NEON
+	auto r = vdupq_n_f32(vgetq_lane_f32(a.v, X));
+	r = vsetq_lane_f32(vgetq_lane_f32(a.v, Y), r, 1);
+	r = vsetq_lane_f32(vgetq_lane_f32(b.v, Z), r, 2);
+	r = vsetq_lane_f32(vgetq_lane_f32(b.v, W), r, 3);
+	return {r};
+#else
+	return make_vec4(a.v.lanes[X], a.v.lanes[Y], b.v.lanes[Z], b.v.lanes[W]);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// generic
+
+template<int X, int Y, int Z, int W>
+vec4 swizzle(const vec4& a)
+{
+	return shuffle<X, Y, Z, W>(a, a);
+}
+
+/// every lane set to lane I
+template<int I>
+vec4 splat_lane(const vec4& a)
+{
+	return shuffle<I, I, I, I>(a, a);
+}
+
+inline vec4 operator*(const vec4& a, float f)
+{
+	return a * splat(f);
+}
+
+/// the sum of all lanes in every lane
+inline vec4 sum_lanes(const vec4& a)
+{
+	const auto pairs = a + swizzle<1, 0, 3, 2>(a);
+	return pairs + swizzle<2, 3, 0, 1>(pairs);
+}
+
+/// the dot product of xyz in every lane, w must be 0 in one of them
+inline vec4 dot3(const vec4& a, const vec4& b)
+{
+	return sum_lanes(a * b);
+}
+
+/// w is 0
+inline vec4 cross(const vec4& a, const vec4& b)
+{
+	return swizzle<1, 2, 0, 3>(a) * swizzle<2, 0, 1, 3>(b)
+		 - swizzle<2, 0, 1, 3>(a) * swizzle<1, 2, 0, 3>(b);
+}
+
+inline vec4 operator*(const mat4& m, const vec4& v)
+{
+	return m.columns[0] * splat_lane<0>(v) + m.columns[1] * splat_lane<1>(v)
+		 + m.columns[2] * splat_lane<2>(v) + m.columns[3] * splat_lane<3>(v);
+}
+
+inline mat4 operator*(const mat4& a, const mat4& b)
+{
+	return {{a * b.columns[0], a * b.columns[1], a * b.columns[2], a * b.columns[3]}};
+}
+
+/// same order as ::quat, a * b applies a first
+inline quat operator*(const quat& a, const quat& b)
+{
+	// the hamilton product b a, one column of the product matrix of b per lane of a
+	const auto& q = a.v;
+	const auto& p = b.v;
+	const auto w = splat_lane<3>(p) * q;
+	const auto x = splat_lane<0>(p) * swizzle<3, 2, 1, 0>(q) * make_vec4(1, -1, 1, -1);
+	const auto y = splat_lane<1>(p) * swizzle<2, 3, 0, 1>(q) * make_vec4(1, 1, -1, -1);
+	const auto z = splat_lane<2>(p) * swizzle<1, 0, 3, 2>(q) * make_vec4(-1, 1, 1, -1);
+	return {w + x + y + z};
+}
+
+/// rotate a vector with w as 0
+inline vec4 operator*(const quat& q, const vec4& v)
+{
+	const auto vector = q.v * make_vec4(1, 1, 1, 0);
+	const auto scalar = splat_lane<3>(q.v);
+	return vector * splat(2.0f) * dot3(vector, v)
+		 + v * (scalar * scalar - dot3(vector, vector))
+		 + cross(vector, v) * splat(2.0f) * scalar;
+}
+
+inline quat get_inverse(const quat& q)
+{
+	const auto length_sq = get_lane(sum_lanes(q.v * q.v), 0);
+	if (length_sq < QUAT_EPSILON)
+	{
+		return {make_vec4(0, 0, 0, 1)};
+	}
+	return {q.v * make_vec4(-1, -1, -1, 1) * (1.0f / length_sq)};
+}
+
+namespace detail
+{
+/// 2x2 matrices stored as (m00, m01, m10, m11), the block inverse from
+/// https://lxjk.github.io/2017/09/03/Fast-4x4-Matrix-Inverse-with-SSE-SIMD-Explained.html
+inline vec4 mat2_mul(const vec4& a, const vec4& b)
+{
+	return a * swizzle<0, 3, 0, 3>(b) + swizzle<1, 0, 3, 2>(a) * swizzle<2, 1, 2, 1>(b);
+}
+
+/// adjugate(a) * b
+inline vec4 mat2_adj_mul(const vec4& a, const vec4& b)
+{
+	return swizzle<3, 3, 0, 0>(a) * b - swizzle<1, 1, 2, 2>(a) * swizzle<2, 3, 0, 1>(b);
+}
+
+/// a * adjugate(b)
+inline vec4 mat2_mul_adj(const vec4& a, const vec4& b)
+{
+	return a * swizzle<3, 0, 3, 0>(b) - swizzle<1, 0, 3, 2>(a) * swizzle<2, 1, 2, 1>(b);
+}
+}  //  namespace detail
+
+/// the identity for a singular matrix like ::get_inverse
+inline mat4 get_inverse(const mat4& m)
+{
+	using namespace detail;
+
+	// the inverse of the transpose is the transposed inverse, so the row major block method works
+	// on the columns as is
+	const auto& c = m.columns;
+	const auto a = shuffle<0, 1, 0, 1>(c[0], c[1]);
+	const auto b = shuffle<2, 3, 2, 3>(c[0], c[1]);
+	const auto cc = shuffle<0, 1, 0, 1>(c[2], c[3]);
+	const auto d = shuffle<2, 3, 2, 3>(c[2], c[3]);
+
+	// the determinants of a, b, c and d
+	const auto sub_determinants
+		= shuffle<0, 2, 0, 2>(c[0], c[2]) * shuffle<1, 3, 1, 3>(c[1], c[3])
+		- shuffle<1, 3, 1, 3>(c[0], c[2]) * shuffle<0, 2, 0, 2>(c[1], c[3]);
+	const auto det_a = splat_lane<0>(sub_determinants);
+	const auto det_b = splat_lane<1>(sub_determinants);
+	const auto det_c = splat_lane<2>(sub_determinants);
+	const auto det_d = splat_lane<3>(sub_determinants);
+
+	const auto d_c = mat2_adj_mul(d, cc);
+	const auto a_b = mat2_adj_mul(a, b);
+	auto x = det_d * a - mat2_mul(b, d_c);
+	auto w = det_a * d - mat2_mul(cc, a_b);
+	auto y = det_b * cc - mat2_mul_adj(d, a_b);
+	auto z = det_c * b - mat2_mul_adj(a, d_c);
+
+	const auto trace = sum_lanes(a_b * swizzle<0, 2, 1, 3>(d_c));
+	const auto determinant = get_lane(det_a * det_d + det_b * det_c - trace, 0);
+	if (determinant == 0.0f)
+	{
+		return {
+			{make_vec4(1, 0, 0, 0),
+			 make_vec4(0, 1, 0, 0),
+			 make_vec4(0, 0, 1, 0),
+			 make_vec4(0, 0, 0, 1)}
+		};
+	}
+
+	const auto scale = make_vec4(1, -1, -1, 1) * (1.0f / determinant);
+	x = x * scale;
+	y = y * scale;
+	z = z * scale;
+	w = w * scale;
+
+	return {
+		{shuffle<3, 1, 3, 1>(x, y),
+		 shuffle<2, 0, 2, 0>(x, y),
+		 shuffle<3, 1, 3, 1>(z, w),
+		 shuffle<2, 0, 2, 0>(z, w)}
+	};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// conversions to and from the packed types
+
+inline vec4 to_simd(const ::vec4& v)
+{
+	return load(v.data_ptr());
+}
+
+/// w is 0
+inline vec4 to_simd(const ::vec3& v)
+{
+	return make_vec4(v.x, v.y, v.z, 0.0f);
+}
+
+inline quat to_simd(const ::quat& q)
+{
+	return {load(q.data_ptr())};
+}
+
+inline mat4 to_simd(const ::mat4& m)
+{
+	const auto* f = m.data_ptr();
+	return {{load(f), load(f + 4), load(f + 8), load(f + 12)}};
+}
+
+inline ::vec4 to_packed(const vec4& v)
+{
+	::vec4 r;
+	store(&r.x, v);
+	return r;
+}
+
+inline ::vec3 to_packed_vec3(const vec4& v)
+{
+	alignas(16) float lanes[4];
+	store(lanes, v);
+	return ::vec3(lanes[0], lanes[1], lanes[2]);
+}
+
+inline ::quat to_packed(const quat& q)
+{
+	::quat r;
+	store(&r.x, q.v);
+	return r;
+}
+
+inline ::mat4 to_packed(const mat4& m)
+{
+	::mat4 r;
+	store(&r.xx, m.columns[0]);
+	store(&r.yx, m.columns[1]);
+	store(&r.zx, m.columns[2]);
+	store(&r.tx, m.columns[3]);
+	return r;
+}
+}  //  namespace simd
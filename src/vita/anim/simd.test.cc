@@ -0,0 +1,40 @@
+#include "catch.hpp"
+
+#include "vita/anim/simd.h"
+#include "vita/anim/transform.h"
+
+TEST_CASE("simd math matches the packed math")
+{
+	const auto a = mat4_from_transform(Transform(
+		vec3(4.0f, 3.0f, 10.0f),
+		quat_from_angle_axis(0.7f, get_normalized(vec3(1.0f, 2.0f, 3.0f))),
+		vec3(1.0f, 2.0f, 0.5f)
+	));
+	const auto b = mat4_from_perspective(60.0f, 1.5f, 0.1f, 100.0f);
+	const auto v = vec4(0.5f, -1.0f, 2.0f, 1.0f);
+
+	CHECK(simd::to_packed(simd::to_simd(a) * simd::to_simd(b)) == a * b);
+	CHECK(simd::to_packed(simd::to_simd(b) * simd::to_simd(a)) == b * a);
+	CHECK(simd::to_packed(simd::get_inverse(simd::to_simd(a))) == get_inverse(a));
+	const auto view = mat4_from_look_at(vec3(1.0f, 2.0f, 3.0f), vec3(), vec3(0.0f, 1.0f, 0.0f));
+	CHECK(simd::to_packed(simd::get_inverse(simd::to_simd(view))) == get_inverse(view));
+	CHECK(simd::to_packed(simd::get_inverse(simd::to_simd(mat4(
+		1, 2, 3, 4, 2, 4, 6, 8, 0, 0, 1, 0, 0, 0, 0, 1
+	)))) == mat4());
+
+	const auto expected = b * v;
+	const auto transformed = simd::to_packed(simd::to_simd(b) * simd::to_simd(v));
+	CHECK(transformed.x == Approx(expected.x));
+	CHECK(transformed.y == Approx(expected.y));
+	CHECK(transformed.z == Approx(expected.z));
+	CHECK(transformed.w == Approx(expected.w));
+
+	const auto p = quat_from_angle_axis(1.2f, get_normalized(vec3(-1.0f, 0.5f, 2.0f)));
+	const auto q = quat_from_angle_axis(-0.4f, get_normalized(vec3(3.0f, 1.0f, 0.0f)));
+	CHECK(simd::to_packed(simd::to_simd(p) * simd::to_simd(q)) == p * q);
+	CHECK(simd::to_packed(simd::to_simd(q) * simd::to_simd(p)) == q * p);
+	CHECK(simd::to_packed(simd::get_inverse(simd::to_simd(p))) == get_inverse(p));
+
+	const auto direction = vec3(1.0f, -2.0f, 0.5f);
+	CHECK(simd::to_packed_vec3(simd::to_simd(p) * simd::to_simd(direction)) == p * direction);
+}
@@ -1,5 +1,7 @@
 #include "vita/anim/skeleton.h"
 
+#include "vita/anim/soatransform.h"
+
 Skeleton::Skeleton()
 {
 }
@@ -12,10 +14,45 @@ Skeleton::Skeleton(const Pose& rest, const Pose& bind, const std::vector<std::st
 	// UpdateInverseBindPose
 	const auto size = bind_pose.size();
 	inverse_bind_pose.resize(size);
+	inverse_bind_affines.resize(size);
+	inverse_bind_dual_quaternions.resize(size);
 
+	SoaTransforms world;
+	world.resize(size);
 	for (unsigned int i = 0; i < size; ++i)
 	{
-		Transform world = calc_global_transform(bind_pose, i);
-		inverse_bind_pose[i] = get_inverse(mat4_from_transform(world));
+		world.set(i, calc_global_transform(bind_pose, i));
+		inverse_bind_dual_quaternions[i]
+			= get_conjugate(dual_quaternion_from_transform(world.get(i)));
+	}
+
+	soa_transform::to_mat4(world, inverse_bind_pose);
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		invert(inverse_bind_pose[i]);
+		inverse_bind_affines[i] = affine3x4_from_mat4(inverse_bind_pose[i]);
+	}
+}
+
+JointOrder sort_joints_parent_before_child(Skeleton& skeleton)
+{
+	const auto order = calc_parent_before_child_order(skeleton.rest_pose);
+
+	remap_joints(skeleton.rest_pose, order);
+	remap_joints(skeleton.bind_pose, order);
+
+	const auto inverse_bind_pose = skeleton.inverse_bind_pose;
+	const auto inverse_bind_affines = skeleton.inverse_bind_affines;
+	const auto inverse_bind_dual_quaternions = skeleton.inverse_bind_dual_quaternions;
+	const auto joint_names = skeleton.joint_names;
+	for (std::size_t joint = 0; joint < order.old_index.size(); ++joint)
+	{
+		const auto old = order.old_index[joint];
+		skeleton.inverse_bind_pose[joint] = inverse_bind_pose[old];
+		skeleton.inverse_bind_affines[joint] = inverse_bind_affines[old];
+		skeleton.inverse_bind_dual_quaternions[joint] = inverse_bind_dual_quaternions[old];
+		skeleton.joint_names[joint] = joint_names[old];
 	}
+
+	return order;
 }
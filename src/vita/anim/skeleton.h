@@ -3,6 +3,7 @@
 #include <vector>
 #include <string>
 
+#include "vita/anim/affine3x4.h"
 #include "vita/anim/mat4.h"
 #include "vita/anim/pose.h"
 
@@ -11,8 +12,15 @@ struct Skeleton
 	Pose rest_pose;
 	Pose bind_pose;
 	std::vector<mat4> inverse_bind_pose;
+	/// inverse_bind_pose without the bottom rows, for affine palettes
+	std::vector<affine3x4> inverse_bind_affines;
+	std::vector<DualQuaternion> inverse_bind_dual_quaternions;
 	std::vector<std::string> joint_names;
 
 	Skeleton();
 	Skeleton(const Pose& rest, const Pose& bind, const std::vector<std::string>& names);
 };
+
+/// reorder the joints so parents come before their children, the meshes, clips and poses using the
+/// skeleton needs to be remapped with the returned order
+JointOrder sort_joints_parent_before_child(Skeleton& skeleton);
@@ -0,0 +1,142 @@
+#include "vita/bench.h"
+
+#include "vita/anim/mesh.h"
+#include "vita/anim/soaskin.h"
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+constexpr std::size_t NUMBER_OF_JOINTS = 43;
+
+std::vector<mat4> make_skin_palette()
+{
+	std::vector<mat4> skin_palette;
+	for (std::size_t joint = 0; joint < NUMBER_OF_JOINTS; ++joint)
+	{
+		const auto f = static_cast<float>(joint);
+		const auto rotation = quat_from_angle_axis(0.1f * f, vec3(0.0f, 1.0f, 0.0f));
+		skin_palette.emplace_back(
+			mat4_from_transform(Transform(vec3(f, 0.5f * f, -f), rotation, vec3(1, 1, 1)))
+		);
+	}
+	return skin_palette;
+}
+
+/// a made up skinned mesh since Mesh needs a GL context
+struct SyntheticMesh
+{
+	std::vector<vec3> positions;
+	std::vector<vec3> normals;
+	std::vector<vec4> weights;
+	std::vector<ivec4> influences;
+};
+
+SyntheticMesh make_synthetic_mesh(std::size_t number_of_vertices)
+{
+	SyntheticMesh mesh;
+	for (std::size_t vertex = 0; vertex < number_of_vertices; ++vertex)
+	{
+		const auto f = static_cast<float>(vertex);
+		const auto joint = [vertex](std::size_t offset)
+		{
+			return static_cast<int>((vertex + offset * 7) % NUMBER_OF_JOINTS);
+		};
+		mesh.positions.emplace_back(std::sin(f), 0.001f * f, std::cos(f));
+		mesh.normals.emplace_back(0.0f, 1.0f, 0.0f);
+		mesh.weights.emplace_back(0.4f, 0.3f, 0.2f, 0.1f);
+		mesh.influences.emplace_back(joint(0), joint(1), joint(2), joint(3));
+	}
+	return mesh;
+}
+}  //  namespace
+
+BENCHMARK("cpu skinning 8k vertices")
+{
+	const auto skin_palette = make_skin_palette();
+	const auto source = make_synthetic_mesh(8000);
+	const auto mesh
+		= make_soa_skin_mesh(source.positions, source.normals, source.weights, source.influences);
+
+	std::vector<vec3> skinned_positions;
+	std::vector<vec3> skinned_normals;
+
+	const auto reference = bench::measure(
+		"reference",
+		[&]()
+		{
+			skin_vertices(
+				source.positions,
+				source.normals,
+				source.weights,
+				source.influences,
+				skin_palette,
+				skinned_positions,
+				skinned_normals
+			);
+			bench::use(skinned_positions[0].x);
+		}
+	);
+
+	for (const auto kernel: {cpu::Kernel::Scalar, cpu::Kernel::Sse, cpu::Kernel::Avx})
+	{
+		if (cpu::is_supported(kernel) == false)
+		{
+			continue;
+		}
+
+		const auto name = std::string{"soa "} + cpu::to_string(kernel);
+		const auto measured = bench::measure(
+			name,
+			[&]()
+			{
+				soa_skin::skin_vertices(
+					mesh, skin_palette, skinned_positions, skinned_normals, kernel
+				);
+				bench::use(skinned_positions[0].x);
+			}
+		);
+		bench::print_speedup(name, reference, measured);
+	}
+}
+
+BENCHMARK("cpu skinning 100k vertices across threads")
+{
+	const auto skin_palette = make_skin_palette();
+	const auto source = make_synthetic_mesh(100000);
+	const auto mesh
+		= make_soa_skin_mesh(source.positions, source.normals, source.weights, source.influences);
+
+	const auto hardware_threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+	std::cout << hardware_threads << " hardware threads\n";
+
+	cpu::CacheAlignedVector<vec3> skinned_positions;
+	cpu::CacheAlignedVector<vec3> skinned_normals;
+
+	double single = 0.0;
+	for (std::size_t threads = 1; threads <= hardware_threads; ++threads)
+	{
+		auto job_system = jobs::JobSystem{threads - 1};
+		const auto name = std::to_string(threads) + " threads";
+		const auto measured = bench::measure(
+			name,
+			[&]()
+			{
+				soa_skin::skin_vertices(
+					job_system, mesh, skin_palette, skinned_positions, skinned_normals
+				);
+				bench::use(skinned_positions[0].x);
+			}
+		);
+
+		if (threads == 1)
+		{
+			single = measured;
+		}
+		else
+		{
+			bench::print_speedup(name, single, measured);
+		}
+	}
+}
@@ -0,0 +1,386 @@
+#include "vita/anim/soaskin.h"
+
+#include "vita/assert.h"
+#include "vita/cpu.h"
+
+#if VITA_X86
+	#include <immintrin.h>
+#endif
+
+std::size_t SoaSkinMesh::size() const
+{
+	return position.x.size();
+}
+
+SoaSkinMesh make_soa_skin_mesh(
+	const std::vector<vec3>& position,
+	const std::vector<vec3>& normal,
+	const std::vector<vec4>& weights,
+	const std::vector<ivec4>& influences
+)
+{
+	const auto size = position.size();
+	ASSERT(normal.size() == size);
+	ASSERT(weights.size() == size);
+	ASSERT(influences.size() == size);
+
+	SoaSkinMesh mesh;
+	for (auto* stream: {&mesh.position, &mesh.normal})
+	{
+		stream->x.resize(size);
+		stream->y.resize(size);
+		stream->z.resize(size);
+	}
+	for (std::size_t influence = 0; influence < 4; ++influence)
+	{
+		mesh.weights[influence].resize(size);
+		mesh.joints[influence].resize(size);
+	}
+
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		mesh.position.x[i] = position[i].x;
+		mesh.position.y[i] = position[i].y;
+		mesh.position.z[i] = position[i].z;
+		mesh.normal.x[i] = normal[i].x;
+		mesh.normal.y[i] = normal[i].y;
+		mesh.normal.z[i] = normal[i].z;
+
+		mesh.weights[0][i] = weights[i].x;
+		mesh.weights[1][i] = weights[i].y;
+		mesh.weights[2][i] = weights[i].z;
+		mesh.weights[3][i] = weights[i].w;
+
+		mesh.joints[0][i] = influences[i].x;
+		mesh.joints[1][i] = influences[i].y;
+		mesh.joints[2][i] = influences[i].z;
+		mesh.joints[3][i] = influences[i].w;
+	}
+
+	return mesh;
+}
+
+namespace soa_skin
+{
+namespace
+{
+using SkinFunction = void (*)(
+	const SoaSkinMesh& mesh,
+	const std::vector<mat4>& skin_palette,
+	std::size_t begin,
+	std::size_t end,
+	vec3* skinned_position,
+	vec3* skinned_normal
+);
+
+const float* get_skin_matrix(
+	const SoaSkinMesh& mesh,
+	const std::vector<mat4>& skin_palette,
+	std::size_t influence,
+	std::size_t i
+)
+{
+	return skin_palette[static_cast<std::size_t>(mesh.joints[influence][i])].data_ptr();
+}
+
+void skin_scalar(
+	const SoaSkinMesh& mesh,
+	const std::vector<mat4>& skin_palette,
+	std::size_t begin,
+	std::size_t end,
+	vec3* skinned_position,
+	vec3* skinned_normal
+)
+{
+	for (auto i = begin; i < end; ++i)
+	{
+		// the blended matrix, column major
+		float m[16] = {};
+		for (std::size_t influence = 0; influence < 4; ++influence)
+		{
+			const auto* skin = get_skin_matrix(mesh, skin_palette, influence, i);
+			const auto weight = mesh.weights[influence][i];
+			for (std::size_t element = 0; element < 16; ++element)
+			{
+				m[element] += skin[element] * weight;
+			}
+		}
+
+		const auto px = mesh.position.x[i];
+		const auto py = mesh.position.y[i];
+		const auto pz = mesh.position.z[i];
+		skinned_position[i] = vec3(
+			m[0] * px + m[4] * py + m[8] * pz + m[12],
+			m[1] * px + m[5] * py + m[9] * pz + m[13],
+			m[2] * px + m[6] * py + m[10] * pz + m[14]
+		);
+
+		const auto nx = mesh.normal.x[i];
+		const auto ny = mesh.normal.y[i];
+		const auto nz = mesh.normal.z[i];
+		skinned_normal[i] = vec3(
+			m[0] * nx + m[4] * ny + m[8] * nz,
+			m[1] * nx + m[5] * ny + m[9] * nz,
+			m[2] * nx + m[6] * ny + m[10] * nz
+		);
+	}
+}
+
+#if VITA_X86
+void store_vec3(vec3* target, __m128 value)
+{
+	_mm_storel_pi(reinterpret_cast<__m64*>(&target->x), value);
+	_mm_store_ss(&target->z, _mm_movehl_ps(value, value));
+}
+
+/// the x, y and z of four vertices written as four packed vec3
+void store_vec3x4(vec3* target, __m128 x, __m128 y, __m128 z)
+{
+	auto w = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS(x, y, z, w);
+
+	// each full store spills one float into the next vertex, which the next store overwrites
+	_mm_storeu_ps(&target[0].x, x);
+	_mm_storeu_ps(&target[1].x, y);
+	_mm_storeu_ps(&target[2].x, z);
+	store_vec3(target + 3, w);
+}
+
+/// skins four vertices per iteration with one vertex per lane, the columns of the four skin
+/// matrices of an influence are transposed so every element is blended with all four weights
+void skin_sse(
+	const SoaSkinMesh& mesh,
+	const std::vector<mat4>& skin_palette,
+	std::size_t begin,
+	std::size_t end,
+	vec3* skinned_position,
+	vec3* skinned_normal
+)
+{
+	auto i = begin;
+	for (; i + 4 <= end; i += 4)
+	{
+		// blended[c][r] is column c and row r of the blended matrices, the bottom row isn't needed
+		__m128 blended[4][3];
+		for (auto& column: blended)
+		{
+			column[0] = column[1] = column[2] = _mm_setzero_ps();
+		}
+
+		for (std::size_t influence = 0; influence < 4; ++influence)
+		{
+			const auto weight = _mm_loadu_ps(&mesh.weights[influence][i]);
+			const float* skin[4] = {
+				get_skin_matrix(mesh, skin_palette, influence, i),
+				get_skin_matrix(mesh, skin_palette, influence, i + 1),
+				get_skin_matrix(mesh, skin_palette, influence, i + 2),
+				get_skin_matrix(mesh, skin_palette, influence, i + 3)
+			};
+			for (std::size_t c = 0; c < 4; ++c)
+			{
+				auto r0 = _mm_loadu_ps(skin[0] + c * 4);
+				auto r1 = _mm_loadu_ps(skin[1] + c * 4);
+				auto r2 = _mm_loadu_ps(skin[2] + c * 4);
+				auto r3 = _mm_loadu_ps(skin[3] + c * 4);
+				_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+				blended[c][0] = _mm_add_ps(blended[c][0], _mm_mul_ps(r0, weight));
+				blended[c][1] = _mm_add_ps(blended[c][1], _mm_mul_ps(r1, weight));
+				blended[c][2] = _mm_add_ps(blended[c][2], _mm_mul_ps(r2, weight));
+			}
+		}
+
+		const auto transform = [&blended](std::size_t r, __m128 x, __m128 y, __m128 z)
+		{
+			return _mm_add_ps(
+				_mm_mul_ps(blended[0][r], x),
+				_mm_add_ps(_mm_mul_ps(blended[1][r], y), _mm_mul_ps(blended[2][r], z))
+			);
+		};
+
+		const auto px = _mm_loadu_ps(&mesh.position.x[i]);
+		const auto py = _mm_loadu_ps(&mesh.position.y[i]);
+		const auto pz = _mm_loadu_ps(&mesh.position.z[i]);
+		store_vec3x4(
+			skinned_position + i,
+			_mm_add_ps(transform(0, px, py, pz), blended[3][0]),
+			_mm_add_ps(transform(1, px, py, pz), blended[3][1]),
+			_mm_add_ps(transform(2, px, py, pz), blended[3][2])
+		);
+
+		const auto nx = _mm_loadu_ps(&mesh.normal.x[i]);
+		const auto ny = _mm_loadu_ps(&mesh.normal.y[i]);
+		const auto nz = _mm_loadu_ps(&mesh.normal.z[i]);
+		store_vec3x4(
+			skinned_normal + i,
+			transform(0, nx, ny, nz),
+			transform(1, nx, ny, nz),
+			transform(2, nx, ny, nz)
+		);
+	}
+
+	skin_scalar(mesh, skin_palette, i, end, skinned_position, skinned_normal);
+}
+
+/// blends two columns of the four skin matrices per instruction, one vertex at a time since the
+/// weights and coordinates are broadcast straight from the streams. Eight vertices per iteration
+/// with the matrices transposed like skin_sse was slower, the transposes need too many shuffles
+VITA_TARGET_AVX void skin_avx(
+	const SoaSkinMesh& mesh,
+	const std::vector<mat4>& skin_palette,
+	std::size_t begin,
+	std::size_t end,
+	vec3* skinned_position,
+	vec3* skinned_normal
+)
+{
+	for (auto i = begin; i < end; ++i)
+	{
+		auto column01 = _mm256_setzero_ps();
+		auto column23 = _mm256_setzero_ps();
+		for (std::size_t influence = 0; influence < 4; ++influence)
+		{
+			const auto* skin = get_skin_matrix(mesh, skin_palette, influence, i);
+			const auto weight = _mm256_set1_ps(mesh.weights[influence][i]);
+			column01 = _mm256_add_ps(column01, _mm256_mul_ps(_mm256_loadu_ps(skin), weight));
+			column23 = _mm256_add_ps(column23, _mm256_mul_ps(_mm256_loadu_ps(skin + 8), weight));
+		}
+
+		const auto px = mesh.position.x[i];
+		const auto py = mesh.position.y[i];
+		const auto pz = mesh.position.z[i];
+		const auto position = _mm256_add_ps(
+			_mm256_mul_ps(column01, _mm256_setr_ps(px, px, px, px, py, py, py, py)),
+			_mm256_mul_ps(column23, _mm256_setr_ps(pz, pz, pz, pz, 1, 1, 1, 1))
+		);
+
+		const auto nx = mesh.normal.x[i];
+		const auto ny = mesh.normal.y[i];
+		const auto nz = mesh.normal.z[i];
+		const auto normal = _mm256_add_ps(
+			_mm256_mul_ps(column01, _mm256_setr_ps(nx, nx, nx, nx, ny, ny, ny, ny)),
+			_mm256_mul_ps(column23, _mm256_setr_ps(nz, nz, nz, nz, 0, 0, 0, 0))
+		);
+
+		store_vec3(
+			skinned_position + i,
+			_mm_add_ps(_mm256_castps256_ps128(position), _mm256_extractf128_ps(position, 1))
+		);
+		store_vec3(
+			skinned_normal + i,
+			_mm_add_ps(_mm256_castps256_ps128(normal), _mm256_extractf128_ps(normal, 1))
+		);
+	}
+
+	_mm256_zeroupper();
+}
+#endif
+
+SkinFunction get_skin_function(Kernel kernel)
+{
+	switch (kernel)
+	{
+#if VITA_X86
+	case Kernel::Sse: return skin_sse;
+	case Kernel::Avx: return skin_avx;
+#endif
+	default: return skin_scalar;
+	}
+}
+}  //  namespace
+
+void skin_vertices(
+	const SoaSkinMesh& mesh,
+	const std::vector<mat4>& skin_palette,
+	std::vector<vec3>& skinned_position,
+	std::vector<vec3>& skinned_normal,
+	Kernel kernel
+)
+{
+	skinned_position.resize(mesh.size());
+	skinned_normal.resize(mesh.size());
+
+	const auto skin = get_skin_function(kernel);
+	skin(mesh, skin_palette, 0, mesh.size(), skinned_position.data(), skinned_normal.data());
+}
+
+void skin_vertices(
+	const SoaSkinMesh& mesh,
+	const std::vector<mat4>& skin_palette,
+	std::vector<vec3>& skinned_position,
+	std::vector<vec3>& skinned_normal
+)
+{
+	static const Kernel best = cpu::get_best_kernel();
+	skin_vertices(mesh, skin_palette, skinned_position, skinned_normal, best);
+}
+
+void skin_range(
+	const SoaSkinMesh& mesh,
+	const std::vector<mat4>& skin_palette,
+	std::size_t begin,
+	std::size_t end,
+	vec3* skinned_position,
+	vec3* skinned_normal
+)
+{
+	static const SkinFunction skin = get_skin_function(cpu::get_best_kernel());
+	skin(mesh, skin_palette, begin, end, skinned_position, skinned_normal);
+}
+
+void skin_range(
+	const SoaSkinMesh& mesh,
+	const std::vector<DualQuaternion>& skin_palette,
+	std::size_t begin,
+	std::size_t end,
+	vec3* skinned_position,
+	vec3* skinned_normal
+)
+{
+	const auto get_skin = [&](std::size_t influence, std::size_t i) -> const DualQuaternion&
+	{
+		return skin_palette[static_cast<std::size_t>(mesh.joints[influence][i])];
+	};
+
+	for (auto i = begin; i < end; ++i)
+	{
+		const auto& first = get_skin(0, i);
+		auto skin = first * mesh.weights[0][i];
+		for (std::size_t influence = 1; influence < 4; ++influence)
+		{
+			// q and -q are the same rotation, blend the one closest to the first influence
+			const auto& dq = get_skin(influence, i);
+			const auto weight = mesh.weights[influence][i];
+			skin = skin + dq * (dot(dq, first) < 0.0f ? -weight : weight);
+		}
+		normalize(skin);
+
+		const auto position = vec3(mesh.position.x[i], mesh.position.y[i], mesh.position.z[i]);
+		const auto normal = vec3(mesh.normal.x[i], mesh.normal.y[i], mesh.normal.z[i]);
+		skinned_position[i] = get_transformed_point(skin, position);
+		skinned_normal[i] = get_transformed_vector(skin, normal);
+	}
+}
+
+void skin_vertices(
+	jobs::JobSystem& job_system,
+	const SoaSkinMesh& mesh,
+	const std::vector<mat4>& skin_palette,
+	cpu::CacheAlignedVector<vec3>& skinned_position,
+	cpu::CacheAlignedVector<vec3>& skinned_normal
+)
+{
+	skinned_position.resize(mesh.size());
+	skinned_normal.resize(mesh.size());
+
+	auto* position = skinned_position.data();
+	auto* normal = skinned_normal.data();
+	job_system.parallel_for(
+		mesh.size(),
+		VERTICES_PER_CHUNK,
+		[&](std::size_t begin, std::size_t end)
+		{
+			skin_range(mesh, skin_palette, begin, end, position, normal);
+		}
+	);
+}
+}  //  namespace soa_skin
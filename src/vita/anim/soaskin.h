@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "vita/cpu.h"
+#include "vita/jobs.h"
+#include "vita/anim/dualquaternion.h"
+#include "vita/anim/mat4.h"
+#include "vita/anim/soastream.h"
+#include "vita/anim/vec3.h"
+#include "vita/anim/vec4.h"
+
+/// the vertex data cpu skinning reads, split into streams so the kernels read each component
+/// directly instead of picking it out of a packed struct
+struct SoaSkinMesh
+{
+	SoaVec3Stream position;
+	SoaVec3Stream normal;
+
+	/// one stream per influence
+	std::array<std::vector<float>, 4> weights;
+	std::array<std::vector<int>, 4> joints;
+
+	std::size_t size() const;
+};
+
+SoaSkinMesh make_soa_skin_mesh(
+	const std::vector<vec3>& position,
+	const std::vector<vec3>& normal,
+	const std::vector<vec4>& weights,
+	const std::vector<ivec4>& influences
+);
+
+/// simd versions of skin_vertices, same result as the reference within float rounding
+namespace soa_skin
+{
+using cpu::Kernel;
+
+/// skin the vertices with a skin palette from calc_skin_palette, the output is packed so it can
+/// be uploaded as is
+void skin_vertices(
+	const SoaSkinMesh& mesh,
+	const std::vector<mat4>& skin_palette,
+	std::vector<vec3>& skinned_position,
+	std::vector<vec3>& skinned_normal
+);
+void skin_vertices(
+	const SoaSkinMesh& mesh,
+	const std::vector<mat4>& skin_palette,
+	std::vector<vec3>& skinned_position,
+	std::vector<vec3>& skinned_normal,
+	Kernel kernel
+);
+
+/// skin the vertices in [begin, end) into outputs that already hold all the vertices
+void skin_range(
+	const SoaSkinMesh& mesh,
+	const std::vector<mat4>& skin_palette,
+	std::size_t begin,
+	std::size_t end,
+	vec3* skinned_position,
+	vec3* skinned_normal
+);
+
+/// dual quaternion skinning of [begin, end), the influences are blended in the same hemisphere as
+/// the first one
+void skin_range(
+	const SoaSkinMesh& mesh,
+	const std::vector<DualQuaternion>& skin_palette,
+	std::size_t begin,
+	std::size_t end,
+	vec3* skinned_position,
+	vec3* skinned_normal
+);
+
+/// the number of vertices each job skins, a whole number of cache lines of output
+constexpr std::size_t VERTICES_PER_CHUNK = 1024;
+static_assert((VERTICES_PER_CHUNK * sizeof(vec3)) % cpu::CACHE_LINE_SIZE == 0);
+
+/// skin the vertices in chunks across the job system, the output is cache line aligned so no two
+/// chunks write to the same line
+void skin_vertices(
+	jobs::JobSystem& job_system,
+	const SoaSkinMesh& mesh,
+	const std::vector<mat4>& skin_palette,
+	cpu::CacheAlignedVector<vec3>& skinned_position,
+	cpu::CacheAlignedVector<vec3>& skinned_normal
+);
+}  //  namespace soa_skin
@@ -0,0 +1,216 @@
+#include "catch.hpp"
+
+#include "vita/anim/mesh.h"
+#include "vita/anim/soaskin.h"
+
+#include <cmath>
+
+TEST_CASE("soa skin kernels match the reference")
+{
+	constexpr std::size_t number_of_joints = 5;
+	constexpr std::size_t number_of_vertices = 37;
+
+	Pose pose(number_of_joints);
+	Pose bind_pose(number_of_joints);
+	for (std::size_t joint = 0; joint < number_of_joints; joint += 1)
+	{
+		const auto f = static_cast<float>(joint);
+		if (joint > 0)
+		{
+			pose[joint].parent = joint - 1;
+			bind_pose[joint].parent = joint - 1;
+		}
+		pose[joint].local = Transform(
+			vec3(f, 1.0f, -0.5f * f),
+			quat_from_angle_axis(0.3f * f, get_normalized(vec3(1.0f, f, 0.5f))),
+			vec3(1.0f, 1.0f + 0.1f * f, 1.0f)
+		);
+		bind_pose[joint].local.position = vec3(0.0f, 1.0f, 0.0f);
+	}
+
+	std::vector<mat4> inverse_bind_pose;
+	for (const auto& bind: calc_matrix_palette(bind_pose))
+	{
+		inverse_bind_pose.emplace_back(get_inverse(bind));
+	}
+	std::vector<mat4> skin_palette;
+	calc_skin_palette(calc_matrix_palette(pose), inverse_bind_pose, skin_palette);
+
+	std::vector<vec3> positions;
+	std::vector<vec3> normals;
+	std::vector<vec4> weights;
+	std::vector<ivec4> influences;
+	for (std::size_t vertex = 0; vertex < number_of_vertices; vertex += 1)
+	{
+		const auto f = static_cast<float>(vertex);
+		const auto joint = [vertex](std::size_t offset)
+		{
+			return static_cast<int>((vertex + offset) % number_of_joints);
+		};
+		positions.emplace_back(std::sin(f), 0.1f * f, std::cos(f));
+		normals.emplace_back(get_normalized(vec3(std::cos(f), 1.0f, std::sin(f))));
+		weights.emplace_back(0.5f, 0.25f, 0.125f, 0.125f);
+		influences.emplace_back(joint(0), joint(1), joint(3), joint(4));
+	}
+
+	std::vector<vec3> expected_positions;
+	std::vector<vec3> expected_normals;
+	skin_vertices(
+		positions, normals, weights, influences, skin_palette, expected_positions, expected_normals
+	);
+
+	const auto mesh = make_soa_skin_mesh(positions, normals, weights, influences);
+	REQUIRE(mesh.size() == number_of_vertices);
+
+	for (const auto kernel: {cpu::Kernel::Scalar, cpu::Kernel::Sse, cpu::Kernel::Avx})
+	{
+		if (cpu::is_supported(kernel) == false)
+		{
+			continue;
+		}
+		INFO(cpu::to_string(kernel));
+
+		std::vector<vec3> skinned_positions;
+		std::vector<vec3> skinned_normals;
+		soa_skin::skin_vertices(mesh, skin_palette, skinned_positions, skinned_normals, kernel);
+		REQUIRE(skinned_positions.size() == number_of_vertices);
+		REQUIRE(skinned_normals.size() == number_of_vertices);
+
+		for (std::size_t vertex = 0; vertex < number_of_vertices; vertex += 1)
+		{
+			const auto position_error
+				= std::sqrt(get_length_sq(skinned_positions[vertex] - expected_positions[vertex]));
+			const auto normal_error
+				= std::sqrt(get_length_sq(skinned_normals[vertex] - expected_normals[vertex]));
+			CHECK(position_error < 0.0001f);
+			CHECK(normal_error < 0.0001f);
+		}
+	}
+}
+
+TEST_CASE("soa skin split across jobs matches a single call")
+{
+	constexpr std::size_t number_of_vertices = soa_skin::VERTICES_PER_CHUNK * 3 + 17;
+
+	std::vector<mat4> skin_palette;
+	for (std::size_t joint = 0; joint < 3; joint += 1)
+	{
+		const auto f = static_cast<float>(joint);
+		skin_palette.emplace_back(mat4_from_transform(
+			Transform(vec3(f, 2.0f, 0.0f), quat_from_angle_axis(f, vec3(0, 1, 0)), vec3(1, 1, 1))
+		));
+	}
+
+	std::vector<vec3> positions;
+	std::vector<vec3> normals;
+	std::vector<vec4> weights;
+	std::vector<ivec4> influences;
+	for (std::size_t vertex = 0; vertex < number_of_vertices; vertex += 1)
+	{
+		const auto f = static_cast<float>(vertex);
+		positions.emplace_back(std::sin(f), 0.01f * f, std::cos(f));
+		normals.emplace_back(0.0f, 1.0f, 0.0f);
+		weights.emplace_back(0.5f, 0.5f, 0.0f, 0.0f);
+		influences.emplace_back(static_cast<int>(vertex % 3), 2, 0, 0);
+	}
+	const auto mesh = make_soa_skin_mesh(positions, normals, weights, influences);
+
+	std::vector<vec3> expected_positions;
+	std::vector<vec3> expected_normals;
+	soa_skin::skin_vertices(mesh, skin_palette, expected_positions, expected_normals);
+
+	for (std::size_t workers = 0; workers < 3; workers += 1)
+	{
+		INFO(workers);
+		auto job_system = jobs::JobSystem{workers};
+		cpu::CacheAlignedVector<vec3> skinned_positions;
+		cpu::CacheAlignedVector<vec3> skinned_normals;
+		soa_skin::skin_vertices(
+			job_system, mesh, skin_palette, skinned_positions, skinned_normals
+		);
+
+		REQUIRE(skinned_positions.size() == number_of_vertices);
+		const auto address = reinterpret_cast<std::uintptr_t>(skinned_positions.data());
+		CHECK(address % cpu::CACHE_LINE_SIZE == 0);
+		CHECK(std::equal(
+			expected_positions.begin(), expected_positions.end(), skinned_positions.begin()
+		));
+		CHECK(std::equal(
+			expected_normals.begin(), expected_normals.end(), skinned_normals.begin()
+		));
+	}
+}
+
+TEST_CASE("dual quaternion skinning matches linear blend skinning for rigid vertices")
+{
+	constexpr std::size_t number_of_joints = 4;
+	constexpr std::size_t number_of_vertices = 20;
+
+	// dual quaternions can't scale so neither does this pose
+	Pose pose(number_of_joints);
+	Pose bind_pose(number_of_joints);
+	for (std::size_t joint = 0; joint < number_of_joints; joint += 1)
+	{
+		const auto f = static_cast<float>(joint);
+		if (joint > 0)
+		{
+			pose[joint].parent = joint - 1;
+			bind_pose[joint].parent = joint - 1;
+		}
+		pose[joint].local.position = vec3(0.5f * f, 1.0f, f);
+		pose[joint].local.rotation = quat_from_angle_axis(0.7f * f, get_normalized(vec3(1, f, 0)));
+		bind_pose[joint].local.position = vec3(0.0f, 1.0f, 0.0f);
+		bind_pose[joint].local.rotation = quat_from_angle_axis(0.2f * f, vec3(0, 0, 1));
+	}
+	const auto skeleton = Skeleton(pose, bind_pose, std::vector<std::string>(number_of_joints));
+
+	std::vector<mat4> skin_palette;
+	calc_skin_palette(calc_matrix_palette(pose), skeleton.inverse_bind_pose, skin_palette);
+	std::vector<DualQuaternion> pose_dual_quaternions;
+	std::vector<DualQuaternion> skin_dual_quaternions;
+	calc_dual_quaternion_palette(pose, pose_dual_quaternions);
+	calc_skin_palette(
+		pose_dual_quaternions, skeleton.inverse_bind_dual_quaternions, skin_dual_quaternions
+	);
+
+	// every vertex follows a single joint so the blend doesn't matter
+	std::vector<vec3> positions;
+	std::vector<vec3> normals;
+	std::vector<vec4> weights;
+	std::vector<ivec4> influences;
+	for (std::size_t vertex = 0; vertex < number_of_vertices; vertex += 1)
+	{
+		const auto f = static_cast<float>(vertex);
+		const auto joint = static_cast<int>(vertex % number_of_joints);
+		positions.emplace_back(std::sin(f), 0.2f * f, std::cos(f));
+		normals.emplace_back(get_normalized(vec3(1.0f, std::sin(f), 0.0f)));
+		weights.emplace_back(1.0f, 0.0f, 0.0f, 0.0f);
+		influences.emplace_back(joint, 0, 0, 0);
+	}
+	const auto mesh = make_soa_skin_mesh(positions, normals, weights, influences);
+
+	std::vector<vec3> expected_positions;
+	std::vector<vec3> expected_normals;
+	soa_skin::skin_vertices(mesh, skin_palette, expected_positions, expected_normals);
+
+	std::vector<vec3> skinned_positions(number_of_vertices);
+	std::vector<vec3> skinned_normals(number_of_vertices);
+	soa_skin::skin_range(
+		mesh,
+		skin_dual_quaternions,
+		0,
+		number_of_vertices,
+		skinned_positions.data(),
+		skinned_normals.data()
+	);
+
+	for (std::size_t vertex = 0; vertex < number_of_vertices; vertex += 1)
+	{
+		const auto position_error
+			= std::sqrt(get_length_sq(skinned_positions[vertex] - expected_positions[vertex]));
+		const auto normal_error
+			= std::sqrt(get_length_sq(skinned_normals[vertex] - expected_normals[vertex]));
+		CHECK(position_error < 0.0001f);
+		CHECK(normal_error < 0.0001f);
+	}
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <vector>
+
+/// one float stream per component
+struct SoaVec3Stream
+{
+	std::vector<float> x;
+	std::vector<float> y;
+	std::vector<float> z;
+};
+
+/// one float stream per quaternion component
+struct SoaQuatStream
+{
+	std::vector<float> x;
+	std::vector<float> y;
+	std::vector<float> z;
+	std::vector<float> w;
+};
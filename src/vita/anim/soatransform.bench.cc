@@ -0,0 +1,66 @@
+#include "vita/bench.h"
+
+#include "vita/anim/soatransform.h"
+
+#include <cmath>
+
+BENCHMARK("transform to mat4 1024 transforms")
+{
+	constexpr std::size_t number_of_transforms = 1024;
+
+	std::vector<Transform> transforms;
+	for (std::size_t index = 0; index < number_of_transforms; ++index)
+	{
+		const auto f = static_cast<float>(index);
+		transforms.emplace_back(
+			vec3(f, 0.5f * f, -f),
+			quat_from_angle_axis(0.1f * f, get_normalized(vec3(std::sin(f), 1.0f, std::cos(f)))),
+			vec3(1.0f, 1.0f + 0.001f * f, 1.0f)
+		);
+	}
+	const auto soa = make_soa_transforms(transforms);
+	std::vector<mat4> matrices(number_of_transforms);
+	std::vector<affine3x4> affines(number_of_transforms);
+
+	const auto reference = bench::measure(
+		"mat4_from_transform",
+		[&]()
+		{
+			for (std::size_t index = 0; index < number_of_transforms; ++index)
+			{
+				matrices[index] = mat4_from_transform(transforms[index]);
+			}
+			bench::use(matrices[0].xx);
+		}
+	);
+
+	for (const auto kernel: {cpu::Kernel::Scalar, cpu::Kernel::Sse, cpu::Kernel::Avx})
+	{
+		if (cpu::is_supported(kernel) == false)
+		{
+			continue;
+		}
+
+		const auto name = std::string{"mat4 "} + cpu::to_string(kernel);
+		const auto measured = bench::measure(
+			name,
+			[&]()
+			{
+				soa_transform::to_mat4(soa, 0, number_of_transforms, matrices.data(), kernel);
+				bench::use(matrices[0].xx);
+			}
+		);
+		bench::print_speedup(name, reference, measured);
+
+		const auto affine_name = std::string{"affine3x4 "} + cpu::to_string(kernel);
+		const auto affine = bench::measure(
+			affine_name,
+			[&]()
+			{
+				soa_transform::to_affine3x4(soa, 0, number_of_transforms, affines.data(), kernel);
+				bench::use(affines[0].xx);
+			}
+		);
+		bench::print_speedup(affine_name, reference, affine);
+	}
+}
@@ -0,0 +1,382 @@
+#include "vita/anim/soatransform.h"
+
+#include "vita/assert.h"
+#include "vita/cpu.h"
+
+#if VITA_X86
+	#include <immintrin.h>
+#endif
+
+std::size_t SoaTransforms::size() const
+{
+	return position.x.size();
+}
+
+void SoaTransforms::resize(std::size_t size)
+{
+	for (auto* stream: {&position, &scale})
+	{
+		stream->x.resize(size);
+		stream->y.resize(size);
+		stream->z.resize(size);
+	}
+	rotation.x.resize(size);
+	rotation.y.resize(size);
+	rotation.z.resize(size);
+	rotation.w.resize(size);
+}
+
+void SoaTransforms::set(std::size_t index, const Transform& transform)
+{
+	position.x[index] = transform.position.x;
+	position.y[index] = transform.position.y;
+	position.z[index] = transform.position.z;
+	rotation.x[index] = transform.rotation.x;
+	rotation.y[index] = transform.rotation.y;
+	rotation.z[index] = transform.rotation.z;
+	rotation.w[index] = transform.rotation.w;
+	scale.x[index] = transform.scale.x;
+	scale.y[index] = transform.scale.y;
+	scale.z[index] = transform.scale.z;
+}
+
+Transform SoaTransforms::get(std::size_t index) const
+{
+	return Transform(
+		vec3(position.x[index], position.y[index], position.z[index]),
+		quat(rotation.x[index], rotation.y[index], rotation.z[index], rotation.w[index]),
+		vec3(scale.x[index], scale.y[index], scale.z[index])
+	);
+}
+
+SoaTransforms make_soa_transforms(const std::vector<Transform>& transforms)
+{
+	SoaTransforms result;
+	result.resize(transforms.size());
+	for (std::size_t i = 0; i < transforms.size(); ++i)
+	{
+		result.set(i, transforms[i]);
+	}
+	return result;
+}
+
+namespace soa_transform
+{
+namespace
+{
+enum class Layout
+{
+	Mat4,
+	Affine3x4
+};
+
+constexpr std::size_t AFFINE3X4_SIZE = sizeof(affine3x4) / sizeof(float);
+
+constexpr std::size_t get_stride(Layout layout)
+{
+	return layout == Layout::Mat4 ? 16 : AFFINE3X4_SIZE;
+}
+
+using ConvertFunction = void (*)(
+	const SoaTransforms& transforms, std::size_t begin, std::size_t end, float* out
+);
+
+/// the rotation matrix is written with the squares of all four components, so like the quat times
+/// vec3 in mat4_from_transform it also scales by the squared length of a non unit quaternion
+template<Layout L>
+void convert_scalar(const SoaTransforms& transforms, std::size_t begin, std::size_t end, float* out)
+{
+	const auto& r = transforms.rotation;
+	const auto& s = transforms.scale;
+	const auto& p = transforms.position;
+	for (auto i = begin; i < end; ++i)
+	{
+		const auto x = r.x[i];
+		const auto y = r.y[i];
+		const auto z = r.z[i];
+		const auto w = r.w[i];
+
+		// columns, one per basis vector and the position
+		const float c[4][3] = {
+			{(w * w + x * x - y * y - z * z) * s.x[i],
+			 2.0f * (x * y + w * z) * s.x[i],
+			 2.0f * (x * z - w * y) * s.x[i]},
+			{2.0f * (x * y - w * z) * s.y[i],
+			 (w * w - x * x + y * y - z * z) * s.y[i],
+			 2.0f * (y * z + w * x) * s.y[i]},
+			{2.0f * (x * z + w * y) * s.z[i],
+			 2.0f * (y * z - w * x) * s.z[i],
+			 (w * w - x * x - y * y + z * z) * s.z[i]},
+			{p.x[i], p.y[i], p.z[i]}
+		};
+
+		auto* m = out + i * get_stride(L);
+		for (std::size_t column = 0; column < 4; ++column)
+		{
+			for (std::size_t row = 0; row < 3; ++row)
+			{
+				if constexpr (L == Layout::Mat4)
+				{
+					m[column * 4 + row] = c[column][row];
+				}
+				else
+				{
+					m[row * 4 + column] = c[column][row];
+				}
+			}
+			if constexpr (L == Layout::Mat4)
+			{
+				m[column * 4 + 3] = column == 3 ? 1.0f : 0.0f;
+			}
+		}
+	}
+}
+
+#if VITA_X86
+/// four transforms per instruction, the columns are transposed back to one matrix per register
+template<Layout L>
+void convert_sse(const SoaTransforms& transforms, std::size_t begin, std::size_t end, float* out)
+{
+	const auto& r = transforms.rotation;
+	const auto& s = transforms.scale;
+	const auto& p = transforms.position;
+
+	auto i = begin;
+	for (; i + 4 <= end; i += 4)
+	{
+		const auto x = _mm_loadu_ps(&r.x[i]);
+		const auto y = _mm_loadu_ps(&r.y[i]);
+		const auto z = _mm_loadu_ps(&r.z[i]);
+		const auto w = _mm_loadu_ps(&r.w[i]);
+		const auto sx = _mm_loadu_ps(&s.x[i]);
+		const auto sy = _mm_loadu_ps(&s.y[i]);
+		const auto sz = _mm_loadu_ps(&s.z[i]);
+
+		const auto xx = _mm_mul_ps(x, x);
+		const auto yy = _mm_mul_ps(y, y);
+		const auto zz = _mm_mul_ps(z, z);
+		const auto ww = _mm_mul_ps(w, w);
+		const auto two = _mm_set1_ps(2.0f);
+		const auto xy = _mm_mul_ps(two, _mm_mul_ps(x, y));
+		const auto xz = _mm_mul_ps(two, _mm_mul_ps(x, z));
+		const auto yz = _mm_mul_ps(two, _mm_mul_ps(y, z));
+		const auto wx = _mm_mul_ps(two, _mm_mul_ps(w, x));
+		const auto wy = _mm_mul_ps(two, _mm_mul_ps(w, y));
+		const auto wz = _mm_mul_ps(two, _mm_mul_ps(w, z));
+
+		// [column][row] of the four matrices
+		__m128 c[4][4] = {
+			{_mm_mul_ps(_mm_sub_ps(_mm_add_ps(ww, xx), _mm_add_ps(yy, zz)), sx),
+			 _mm_mul_ps(_mm_add_ps(xy, wz), sx),
+			 _mm_mul_ps(_mm_sub_ps(xz, wy), sx),
+			 _mm_setzero_ps()},
+			{_mm_mul_ps(_mm_sub_ps(xy, wz), sy),
+			 _mm_mul_ps(_mm_sub_ps(_mm_add_ps(ww, yy), _mm_add_ps(xx, zz)), sy),
+			 _mm_mul_ps(_mm_add_ps(yz, wx), sy),
+			 _mm_setzero_ps()},
+			{_mm_mul_ps(_mm_add_ps(xz, wy), sz),
+			 _mm_mul_ps(_mm_sub_ps(yz, wx), sz),
+			 _mm_mul_ps(_mm_sub_ps(_mm_add_ps(ww, zz), _mm_add_ps(xx, yy)), sz),
+			 _mm_setzero_ps()},
+			{_mm_loadu_ps(&p.x[i]), _mm_loadu_ps(&p.y[i]), _mm_loadu_ps(&p.z[i]), _mm_set1_ps(1.0f)}
+		};
+
+		auto* m = out + i * get_stride(L);
+		if constexpr (L == Layout::Mat4)
+		{
+			for (std::size_t column = 0; column < 4; ++column)
+			{
+				_MM_TRANSPOSE4_PS(c[column][0], c[column][1], c[column][2], c[column][3]);
+				for (std::size_t matrix = 0; matrix < 4; ++matrix)
+				{
+					_mm_storeu_ps(m + matrix * 16 + column * 4, c[column][matrix]);
+				}
+			}
+		}
+		else
+		{
+			for (std::size_t row = 0; row < 3; ++row)
+			{
+				auto c0 = c[0][row];
+				auto c1 = c[1][row];
+				auto c2 = c[2][row];
+				auto c3 = c[3][row];
+				_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+				_mm_storeu_ps(m + row * 4, c0);
+				_mm_storeu_ps(m + AFFINE3X4_SIZE + row * 4, c1);
+				_mm_storeu_ps(m + AFFINE3X4_SIZE * 2 + row * 4, c2);
+				_mm_storeu_ps(m + AFFINE3X4_SIZE * 3 + row * 4, c3);
+			}
+		}
+	}
+
+	convert_scalar<L>(transforms, i, end, out);
+}
+
+/// _MM_TRANSPOSE4_PS on both 128 bit halves
+VITA_TARGET_AVX inline void transpose_halves(__m256& a, __m256& b, __m256& c, __m256& d)
+{
+	const auto ab_low = _mm256_unpacklo_ps(a, b);
+	const auto cd_low = _mm256_unpacklo_ps(c, d);
+	const auto ab_high = _mm256_unpackhi_ps(a, b);
+	const auto cd_high = _mm256_unpackhi_ps(c, d);
+	a = _mm256_shuffle_ps(ab_low, cd_low, _MM_SHUFFLE(1, 0, 1, 0));
+	b = _mm256_shuffle_ps(ab_low, cd_low, _MM_SHUFFLE(3, 2, 3, 2));
+	c = _mm256_shuffle_ps(ab_high, cd_high, _MM_SHUFFLE(1, 0, 1, 0));
+	d = _mm256_shuffle_ps(ab_high, cd_high, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+/// the low half to target and the high half to the matrix four strides later
+VITA_TARGET_AVX inline void store_halves(float* target, std::size_t stride, __m256 value)
+{
+	_mm_storeu_ps(target, _mm256_castps256_ps128(value));
+	_mm_storeu_ps(target + stride * 4, _mm256_extractf128_ps(value, 1));
+}
+
+/// eight transforms per instruction, after the transpose the low half of each register is one of
+/// the first four matrices and the high half one of the last four
+template<Layout L>
+VITA_TARGET_AVX void convert_avx(
+	const SoaTransforms& transforms, std::size_t begin, std::size_t end, float* out
+)
+{
+	const auto& r = transforms.rotation;
+	const auto& s = transforms.scale;
+	const auto& p = transforms.position;
+
+	auto i = begin;
+	for (; i + 8 <= end; i += 8)
+	{
+		const auto x = _mm256_loadu_ps(&r.x[i]);
+		const auto y = _mm256_loadu_ps(&r.y[i]);
+		const auto z = _mm256_loadu_ps(&r.z[i]);
+		const auto w = _mm256_loadu_ps(&r.w[i]);
+		const auto sx = _mm256_loadu_ps(&s.x[i]);
+		const auto sy = _mm256_loadu_ps(&s.y[i]);
+		const auto sz = _mm256_loadu_ps(&s.z[i]);
+
+		const auto xx = _mm256_mul_ps(x, x);
+		const auto yy = _mm256_mul_ps(y, y);
+		const auto zz = _mm256_mul_ps(z, z);
+		const auto ww = _mm256_mul_ps(w, w);
+		const auto two = _mm256_set1_ps(2.0f);
+		const auto xy = _mm256_mul_ps(two, _mm256_mul_ps(x, y));
+		const auto xz = _mm256_mul_ps(two, _mm256_mul_ps(x, z));
+		const auto yz = _mm256_mul_ps(two, _mm256_mul_ps(y, z));
+		const auto wx = _mm256_mul_ps(two, _mm256_mul_ps(w, x));
+		const auto wy = _mm256_mul_ps(two, _mm256_mul_ps(w, y));
+		const auto wz = _mm256_mul_ps(two, _mm256_mul_ps(w, z));
+
+		__m256 c[4][4] = {
+			{_mm256_mul_ps(_mm256_sub_ps(_mm256_add_ps(ww, xx), _mm256_add_ps(yy, zz)), sx),
+			 _mm256_mul_ps(_mm256_add_ps(xy, wz), sx),
+			 _mm256_mul_ps(_mm256_sub_ps(xz, wy), sx),
+			 _mm256_setzero_ps()},
+			{_mm256_mul_ps(_mm256_sub_ps(xy, wz), sy),
+			 _mm256_mul_ps(_mm256_sub_ps(_mm256_add_ps(ww, yy), _mm256_add_ps(xx, zz)), sy),
+			 _mm256_mul_ps(_mm256_add_ps(yz, wx), sy),
+			 _mm256_setzero_ps()},
+			{_mm256_mul_ps(_mm256_add_ps(xz, wy), sz),
+			 _mm256_mul_ps(_mm256_sub_ps(yz, wx), sz),
+			 _mm256_mul_ps(_mm256_sub_ps(_mm256_add_ps(ww, zz), _mm256_add_ps(xx, yy)), sz),
+			 _mm256_setzero_ps()},
+			{_mm256_loadu_ps(&p.x[i]),
+			 _mm256_loadu_ps(&p.y[i]),
+			 _mm256_loadu_ps(&p.z[i]),
+			 _mm256_set1_ps(1.0f)}
+		};
+
+		constexpr auto stride = get_stride(L);
+		auto* m = out + i * stride;
+		if constexpr (L == Layout::Mat4)
+		{
+			for (std::size_t column = 0; column < 4; ++column)
+			{
+				transpose_halves(c[column][0], c[column][1], c[column][2], c[column][3]);
+				for (std::size_t matrix = 0; matrix < 4; ++matrix)
+				{
+					store_halves(m + matrix * stride + column * 4, stride, c[column][matrix]);
+				}
+			}
+		}
+		else
+		{
+			for (std::size_t row = 0; row < 3; ++row)
+			{
+				transpose_halves(c[0][row], c[1][row], c[2][row], c[3][row]);
+				for (std::size_t matrix = 0; matrix < 4; ++matrix)
+				{
+					store_halves(m + matrix * stride + row * 4, stride, c[matrix][row]);
+				}
+			}
+		}
+	}
+
+	_mm256_zeroupper();
+	convert_scalar<L>(transforms, i, end, out);
+}
+#endif
+
+template<Layout L>
+ConvertFunction get_convert_function(Kernel kernel)
+{
+	switch (kernel)
+	{
+#if VITA_X86
+	case Kernel::Sse: return convert_sse<L>;
+	case Kernel::Avx: return convert_avx<L>;
+#endif
+	default: return convert_scalar<L>;
+	}
+}
+}  //  namespace
+
+void to_mat4(
+	const SoaTransforms& transforms, std::size_t begin, std::size_t end, mat4* out, Kernel kernel
+)
+{
+	ASSERT(end <= transforms.size());
+	const auto convert = get_convert_function<Layout::Mat4>(kernel);
+	// out may be null for an empty range, so don't go through a member
+	convert(transforms, begin, end, reinterpret_cast<float*>(out));
+}
+
+void to_mat4(const SoaTransforms& transforms, std::size_t begin, std::size_t end, mat4* out)
+{
+	static const Kernel best = cpu::get_best_kernel();
+	to_mat4(transforms, begin, end, out, best);
+}
+
+void to_mat4(const SoaTransforms& transforms, std::vector<mat4>& out)
+{
+	out.resize(transforms.size());
+	to_mat4(transforms, 0, transforms.size(), out.data());
+}
+
+void to_affine3x4(
+	const SoaTransforms& transforms,
+	std::size_t begin,
+	std::size_t end,
+	affine3x4* out,
+	Kernel kernel
+)
+{
+	ASSERT(end <= transforms.size());
+	const auto convert = get_convert_function<Layout::Affine3x4>(kernel);
+	convert(transforms, begin, end, reinterpret_cast<float*>(out));
+}
+
+void to_affine3x4(
+	const SoaTransforms& transforms, std::size_t begin, std::size_t end, affine3x4* out
+)
+{
+	static const Kernel best = cpu::get_best_kernel();
+	to_affine3x4(transforms, begin, end, out, best);
+}
+
+void to_affine3x4(const SoaTransforms& transforms, std::vector<affine3x4>& out)
+{
+	out.resize(transforms.size());
+	to_affine3x4(transforms, 0, transforms.size(), out.data());
+}
+}  //  namespace soa_transform
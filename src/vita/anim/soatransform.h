@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+
+#include "vita/cpu.h"
+#include "vita/anim/affine3x4.h"
+#include "vita/anim/mat4.h"
+#include "vita/anim/soastream.h"
+#include "vita/anim/transform.h"
+
+/// transforms split into one stream per component, so the batch conversions can load the same
+/// component of several transforms at once
+struct SoaTransforms
+{
+	SoaVec3Stream position;
+	SoaQuatStream rotation;
+	SoaVec3Stream scale;
+
+	std::size_t size() const;
+	void resize(std::size_t size);
+
+	void set(std::size_t index, const Transform& transform);
+	Transform get(std::size_t index) const;
+};
+
+SoaTransforms make_soa_transforms(const std::vector<Transform>& transforms);
+
+/// batch versions of mat4_from_transform, the rotation comes directly from the quaternion
+/// instead of rotating the three basis vectors, same result within float rounding
+namespace soa_transform
+{
+using cpu::Kernel;
+
+/// convert [begin, end) to out[begin] to out[end - 1]
+void to_mat4(const SoaTransforms& transforms, std::size_t begin, std::size_t end, mat4* out);
+void to_mat4(
+	const SoaTransforms& transforms, std::size_t begin, std::size_t end, mat4* out, Kernel kernel
+);
+
+/// convert every transform, reusing the memory of the result
+void to_mat4(const SoaTransforms& transforms, std::vector<mat4>& out);
+
+/// convert [begin, end) to out[begin] to out[end - 1]
+void to_affine3x4(
+	const SoaTransforms& transforms, std::size_t begin, std::size_t end, affine3x4* out
+);
+void to_affine3x4(
+	const SoaTransforms& transforms,
+	std::size_t begin,
+	std::size_t end,
+	affine3x4* out,
+	Kernel kernel
+);
+
+/// convert every transform, reusing the memory of the result
+void to_affine3x4(const SoaTransforms& transforms, std::vector<affine3x4>& out);
+}  //  namespace soa_transform
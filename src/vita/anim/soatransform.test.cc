@@ -0,0 +1,51 @@
+#include "catch.hpp"
+
+#include "vita/anim/soatransform.h"
+
+#include <cmath>
+
+TEST_CASE("soa transform kernels match mat4_from_transform")
+{
+	// not a multiple of 4 or 8 so the scalar tail runs too
+	constexpr std::size_t number_of_transforms = 21;
+	constexpr std::size_t begin = 2;
+
+	std::vector<Transform> transforms;
+	for (std::size_t index = 0; index < number_of_transforms; index += 1)
+	{
+		const auto f = static_cast<float>(index);
+		transforms.emplace_back(
+			vec3(f, std::sin(f), -0.5f * f),
+			quat_from_angle_axis(0.3f * f, get_normalized(vec3(1.0f, f, std::cos(f)))),
+			vec3(1.0f, 1.0f + 0.1f * f, 2.0f - 0.05f * f)
+		);
+	}
+	const auto soa = make_soa_transforms(transforms);
+	REQUIRE(soa.size() == number_of_transforms);
+	CHECK(soa.get(5) == transforms[5]);
+
+	for (const auto kernel: {cpu::Kernel::Scalar, cpu::Kernel::Sse, cpu::Kernel::Avx})
+	{
+		if (cpu::is_supported(kernel) == false)
+		{
+			continue;
+		}
+		INFO(cpu::to_string(kernel));
+
+		std::vector<mat4> matrices(number_of_transforms);
+		const auto untouched = affine3x4(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+		std::vector<affine3x4> affines(number_of_transforms, untouched);
+		soa_transform::to_mat4(soa, begin, number_of_transforms, matrices.data(), kernel);
+		soa_transform::to_affine3x4(soa, begin, number_of_transforms, affines.data(), kernel);
+
+		CHECK(matrices[begin - 1] == mat4());
+		CHECK(affines[begin - 1] == untouched);
+		for (auto index = begin; index < number_of_transforms; index += 1)
+		{
+			const auto expected = mat4_from_transform(transforms[index]);
+			CHECK(matrices[index] == expected);
+
+			CHECK(affines[index] == affine3x4_from_mat4(expected));
+		}
+	}
+}
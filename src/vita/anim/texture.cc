@@ -2,7 +2,11 @@
 
 #include "stb_image.h"
 
+#include "vita/assert.h"
+#include "vita/glstate.h"
+
 #include <iostream>
+#include <utility>
 
 void CompleteLoad(
 	Texture* out, const std::string& name, int width, int height, int channels, unsigned char* data
@@ -25,7 +29,7 @@ void CompleteLoad(
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-	glBindTexture(GL_TEXTURE_2D, 0);
+	glstate::bind_texture(0, GL_TEXTURE_2D, 0);
 
 	out->width = static_cast<unsigned int>(width);
 	out->height = static_cast<unsigned int>(height);
@@ -34,7 +38,7 @@ void CompleteLoad(
 
 void LoadFromFile(Texture* out, const TextureFromFile& path)
 {
-	glBindTexture(GL_TEXTURE_2D, out->handle);
+	glstate::bind_texture(0, GL_TEXTURE_2D, out->handle);
 
 	int width, height, channels;
 	auto data = stbi_load(path.path.c_str(), &width, &height, &channels, 4);
@@ -44,7 +48,7 @@ void LoadFromFile(Texture* out, const TextureFromFile& path)
 
 void LoadFromMemory(Texture* out, const TextureData& tex)
 {
-	glBindTexture(GL_TEXTURE_2D, out->handle);
+	glstate::bind_texture(0, GL_TEXTURE_2D, out->handle);
 
 	int width, height, channels;
 
@@ -66,22 +70,80 @@ Texture::Texture(const TextureData& data)
 	LoadFromMemory(this, data);
 }
 
+Texture::Texture(const TextureFloatData& data)
+	: width(data.width)
+	, height(data.height)
+	, channels(4)
+{
+	// a larger texture fails to upload, leaving texelFetch reading nothing, so a bake at too high a
+	// rate or with too many joints should fail here instead
+	GLint max_size = 0;
+	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_size);
+	ASSERT(width <= static_cast<unsigned int>(max_size));
+	ASSERT(height <= static_cast<unsigned int>(max_size));
+
+	glGenTextures(1, &handle);
+	glstate::bind_texture(0, GL_TEXTURE_2D, handle);
+
+	glTexImage2D(
+		GL_TEXTURE_2D,
+		0,
+		GL_RGBA32F,
+		static_cast<GLsizei>(width),
+		static_cast<GLsizei>(height),
+		0,
+		GL_RGBA,
+		GL_FLOAT,
+		data.texels
+	);
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+	glstate::bind_texture(0, GL_TEXTURE_2D, 0);
+}
+
 Texture::~Texture()
 {
-	glDeleteTextures(1, &handle);
-	handle = 0;
+	if (handle != 0)
+	{
+		glstate::invalidate();
+		glDeleteTextures(1, &handle);
+		handle = 0;
+	}
+}
+
+Texture::Texture(Texture&& other) noexcept
+	: width(std::exchange(other.width, 0))
+	, height(std::exchange(other.height, 0))
+	, channels(std::exchange(other.channels, 0))
+	, handle(std::exchange(other.handle, 0))
+{
+}
+
+Texture& Texture::operator=(Texture&& other) noexcept
+{
+	if (this != &other)
+	{
+		Texture old{std::move(*this)};
+		width = std::exchange(other.width, 0);
+		height = std::exchange(other.height, 0);
+		channels = std::exchange(other.channels, 0);
+		handle = std::exchange(other.handle, 0);
+	}
+	return *this;
 }
 
 void Texture::bind(int uniformIndex, unsigned int textureIndex)
 {
-	glActiveTexture(GL_TEXTURE0 + textureIndex);
-	glBindTexture(GL_TEXTURE_2D, handle);
+	glstate::bind_texture(textureIndex, GL_TEXTURE_2D, handle);
 	glUniform1i(uniformIndex, textureIndex);
+	glstate::count_calls(1);
 }
 
-void Texture::unbind(unsigned int textureIndex)
+void Texture::unbind(unsigned int)
 {
-	glActiveTexture(GL_TEXTURE0 + textureIndex);
-	glBindTexture(GL_TEXTURE_2D, 0);
-	glActiveTexture(GL_TEXTURE0);
+	// left bound, the next bind to the unit replaces it
 }
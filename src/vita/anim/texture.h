@@ -12,6 +12,14 @@ struct TextureData
 	std::string name;
 };
 
+/// RGBA 32 bit float texels, read with texelFetch so there is no filtering or mipmaps
+struct TextureFloatData
+{
+	unsigned int width;
+	unsigned int height;
+	const float* texels;
+};
+
 struct Texture
 {
 	unsigned int width;
@@ -22,11 +30,12 @@ struct Texture
 
 	Texture(const TextureFromFile& path);
 	Texture(const TextureData& data);
+	Texture(const TextureFloatData& data);
 	~Texture();
 
 	Texture() = delete;
-	Texture(Texture&& other) = delete;
-	void operator=(Texture&& other) = delete;
+	Texture(Texture&& other) noexcept;
+	Texture& operator=(Texture&& other) noexcept;
 	Texture(const Texture& other) = delete;
 	void operator=(const Texture& other) = delete;
 
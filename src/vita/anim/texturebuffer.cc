@@ -0,0 +1,43 @@
+#include "vita/anim/texturebuffer.h"
+
+#include "vita/glstate.h"
+
+TextureBuffer::TextureBuffer()
+	: buffer(0)
+	, texture(0)
+{
+	glGenBuffers(1, &buffer);
+	glGenTextures(1, &texture);
+
+	glstate::bind_texture(0, GL_TEXTURE_BUFFER, texture);
+	glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, buffer);
+}
+
+TextureBuffer::~TextureBuffer()
+{
+	glstate::invalidate();
+	glDeleteTextures(1, &texture);
+	glDeleteBuffers(1, &buffer);
+}
+
+void TextureBuffer::set(const std::vector<mat4>& matrices)
+{
+	const auto size = static_cast<GLsizeiptr>(matrices.size() * sizeof(mat4));
+
+	glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+	glBufferData(GL_TEXTURE_BUFFER, size, matrices.data(), GL_STREAM_DRAW);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+	glstate::count_calls(3);
+}
+
+void TextureBuffer::bind(int uniformIndex, unsigned int textureIndex)
+{
+	glstate::bind_texture(textureIndex, GL_TEXTURE_BUFFER, texture);
+	glUniform1i(uniformIndex, static_cast<GLint>(textureIndex));
+	glstate::count_calls(1);
+}
+
+void TextureBuffer::unbind(unsigned int)
+{
+	// left bound, the next bind to the unit replaces it
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <vector>
+
+#include "vita/anim/mat4.h"
+
+/// a buffer of RGBA32F texels the shaders read with texelFetch from a samplerBuffer, unlike a
+/// uniform block it can hold megabytes so it fits the palettes of a whole crowd
+struct TextureBuffer
+{
+	unsigned int buffer;
+	unsigned int texture;
+
+	TextureBuffer();
+	~TextureBuffer();
+
+	TextureBuffer(const TextureBuffer& other) = delete;
+	void operator=(const TextureBuffer& other) = delete;
+	TextureBuffer(TextureBuffer&& other) = delete;
+	void operator=(TextureBuffer&& other) = delete;
+
+	/// a mat4 is 4 texels, one per column
+	void set(const std::vector<mat4>& matrices);
+
+	void bind(int uniformIndex, unsigned int textureIndex);
+	void unbind(unsigned int textureIndex);
+};
@@ -0,0 +1,77 @@
+#include "vita/bench.h"
+
+#include "vita/anim/track.h"
+#include "vita/anim/timesearch.h"
+
+#include <random>
+
+namespace
+{
+constexpr std::size_t NUMBER_OF_QUERIES = 1024;
+
+/// compare the frame search in Track with every supported kernel on the same random queries
+void bench_time_search(std::size_t number_of_keys)
+{
+	std::vector<ScalarFrame> frames;
+	std::vector<float> times;
+	for (std::size_t i = 0; i < number_of_keys; ++i)
+	{
+		const auto time = static_cast<float>(i) / 30.0f;
+		frames.emplace_back(time, 0.0f, 0.0f, 0.0f);
+		times.emplace_back(time);
+	}
+	const auto track = ScalarTrack{frames, Interpolation::Linear};
+
+	std::mt19937 generator{42};
+	std::uniform_real_distribution<float> distribution{0.0f, track.get_end_time()};
+	std::vector<float> queries;
+	for (std::size_t i = 0; i < NUMBER_OF_QUERIES; ++i)
+	{
+		queries.emplace_back(distribution(generator));
+	}
+
+	const auto baseline = bench::measure(
+		"Track::get_frame_index",
+		[&]()
+		{
+			for (const auto query: queries)
+			{
+				bench::use(static_cast<float>(track.get_frame_index(query, false)));
+			}
+		}
+	);
+
+	for (const auto kernel: {cpu::Kernel::Scalar, cpu::Kernel::Sse, cpu::Kernel::Avx})
+	{
+		if (cpu::is_supported(kernel) == false)
+		{
+			continue;
+		}
+
+		const auto name = std::string{"time_search "} + cpu::to_string(kernel);
+		const auto measured = bench::measure(
+			name,
+			[&]()
+			{
+				for (const auto query: queries)
+				{
+					bench::use(static_cast<float>(
+						time_search::find_index(times.data(), times.size(), query, kernel)
+					));
+				}
+			}
+		);
+		bench::print_speedup(name, baseline, measured);
+	}
+}
+}  //  namespace
+
+BENCHMARK("time search 10 keys")
+{
+	bench_time_search(10);
+}
+
+BENCHMARK("time search 10k keys")
+{
+	bench_time_search(10000);
+}
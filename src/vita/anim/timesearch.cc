@@ -0,0 +1,128 @@
+#include "vita/anim/timesearch.h"
+
+#include "vita/cpu.h"
+
+#include <algorithm>
+
+#if VITA_X86
+	#include <immintrin.h>
+#endif
+
+namespace time_search
+{
+namespace
+{
+/// long tracks are binary searched until this many keys remain, the kernel scans the rest
+constexpr std::size_t SIMD_WINDOW = 32;
+
+/// the number of set bits in a 4 bit mask
+constexpr std::size_t BITS_SET[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+
+using CountFunction = std::size_t (*)(const float* times, std::size_t count, float time);
+
+/// the number of leading keys less or equal to the time, the keys are sorted so stop at the first
+/// that is greater
+std::size_t count_keys_scalar(const float* times, std::size_t count, float time)
+{
+	std::size_t index = 0;
+	while (index < count && times[index] <= time)
+	{
+		index += 1;
+	}
+	return index;
+}
+
+#if VITA_X86
+std::size_t count_keys_sse(const float* times, std::size_t count, float time)
+{
+	const auto splat = _mm_set1_ps(time);
+
+	std::size_t index = 0;
+	for (; index + 4 <= count; index += 4)
+	{
+		const auto keys = _mm_loadu_ps(times + index);
+		const auto mask = static_cast<std::size_t>(_mm_movemask_ps(_mm_cmple_ps(keys, splat)));
+		if (mask != 0xF)
+		{
+			return index + BITS_SET[mask];
+		}
+	}
+
+	return index + count_keys_scalar(times + index, count - index, time);
+}
+
+VITA_TARGET_AVX std::size_t count_keys_avx(const float* times, std::size_t count, float time)
+{
+	const auto splat = _mm256_set1_ps(time);
+
+	std::size_t index = 0;
+	for (; index + 8 <= count; index += 8)
+	{
+		const auto keys = _mm256_loadu_ps(times + index);
+		const auto mask = static_cast<std::size_t>(
+			_mm256_movemask_ps(_mm256_cmp_ps(keys, splat, _CMP_LE_OQ))
+		);
+		if (mask != 0xFF)
+		{
+			return index + BITS_SET[mask & 0xF] + BITS_SET[mask >> 4];
+		}
+	}
+
+	// avoid the penalty of mixing avx and sse code in the tail
+	_mm256_zeroupper();
+	return index + count_keys_sse(times + index, count - index, time);
+}
+#endif
+
+int find_index_scalar(const float* times, std::size_t count, float time)
+{
+	// also catches nan
+	if (count == 0 || (time >= times[0]) == false)
+	{
+		return -1;
+	}
+
+	const auto found = std::upper_bound(times, times + count, time);
+	return static_cast<int>(found - times) - 1;
+}
+
+int find_index_simd(const float* times, std::size_t count, float time, CountFunction count_keys)
+{
+	// everything before low is less or equal to the time, everything from high is greater
+	std::size_t low = 0;
+	std::size_t high = count;
+	while (high - low > SIMD_WINDOW)
+	{
+		const auto middle = low + (high - low) / 2;
+		if (times[middle] <= time)
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+
+	return static_cast<int>(low + count_keys(times + low, high - low, time)) - 1;
+}
+}  //  namespace
+
+int find_index(const float* times, std::size_t count, float time, Kernel kernel)
+{
+	switch (kernel)
+	{
+#if VITA_X86
+	case Kernel::Sse: return find_index_simd(times, count, time, count_keys_sse);
+	case Kernel::Avx: return find_index_simd(times, count, time, count_keys_avx);
+#endif
+	default: return find_index_scalar(times, count, time);
+	}
+}
+
+int find_index(const float* times, std::size_t count, float time)
+{
+	static const Kernel best = cpu::get_best_kernel();
+	return find_index(times, count, time, best);
+}
+}  //  namespace time_search
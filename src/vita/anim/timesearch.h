@@ -0,0 +1,15 @@
+#pragma once
+
+#include "vita/cpu.h"
+
+#include <cstddef>
+
+/// finds the key before a time in a sorted array of key times, several keys at a time
+namespace time_search
+{
+using cpu::Kernel;
+
+/// the last index with a time less or equal to the given time, -1 if before the first time or nan
+int find_index(const float* times, std::size_t count, float time);
+int find_index(const float* times, std::size_t count, float time, Kernel kernel);
+}  //  namespace time_search
@@ -0,0 +1,298 @@
+#include "vita/bench.h"
+
+#include "vita/assets.h"
+#include "vita/anim/clip.h"
+#include "vita/anim/gltfloader.h"
+#include "vita/anim/keyreduction.h"
+#include "vita/anim/posebatch.h"
+
+#include <iostream>
+
+namespace
+{
+constexpr float SAMPLE_RATE = 60.0f;
+
+struct WomanClips
+{
+	Pose rest_pose;
+	std::vector<Clip> clips;
+	std::vector<PackedClip> packed_clips;
+};
+
+WomanClips load_woman_clips()
+{
+	WomanClips result;
+	cgltf_data* gltf = load_gltf_file(assets::woman_gltf());
+	result.rest_pose = get_rest_pose(gltf);
+	result.clips = get_animation_clips(gltf);
+	result.packed_clips = get_packed_animation_clips(gltf);
+	free_gltf_file(gltf);
+	return result;
+}
+
+/// play every clip from start to end at a fixed frame rate
+template<typename TClip, typename Sampler>
+void play_clips(const std::vector<TClip>& clips, Pose& pose, Sampler sampler)
+{
+	for (std::size_t clip_index = 0; clip_index < clips.size(); ++clip_index)
+	{
+		const auto& clip = clips[clip_index];
+		for (float time = clip.duration.start; time < clip.duration.end;
+			 time += 1.0f / SAMPLE_RATE)
+		{
+			sampler(clip_index, clip, time);
+		}
+		bench::use(pose[0].local.position.x);
+	}
+}
+}  //  namespace
+
+BENCHMARK("track sampling woman.gltf")
+{
+	const auto woman = load_woman_clips();
+
+	std::vector<FastClip> fast_clips;
+	for (const auto& clip: woman.clips)
+	{
+		fast_clips.emplace_back(optimize_clip(clip));
+	}
+
+	auto pose = woman.rest_pose;
+	std::vector<ClipCursor> cursors(woman.clips.size());
+
+	const auto search = bench::measure(
+		"Clip",
+		[&]()
+		{
+			play_clips(
+				woman.clips,
+				pose,
+				[&](std::size_t, const Clip& clip, float time) { clip.sample_to_pose(pose, time); }
+			);
+		}
+	);
+	const auto cursor = bench::measure(
+		"Clip + ClipCursor",
+		[&]()
+		{
+			play_clips(
+				woman.clips,
+				pose,
+				[&](std::size_t index, const Clip& clip, float time)
+				{ clip.sample_to_pose(pose, time, cursors[index]); }
+			);
+		}
+	);
+	const auto fast = bench::measure(
+		"FastClip",
+		[&]()
+		{
+			play_clips(
+				fast_clips,
+				pose,
+				[&](std::size_t, const FastClip& clip, float time)
+				{ clip.sample_to_pose(pose, time); }
+			);
+		}
+	);
+
+	const auto packed = bench::measure(
+		"PackedClip",
+		[&]()
+		{
+			play_clips(
+				woman.packed_clips,
+				pose,
+				[&](std::size_t, const PackedClip& clip, float time)
+				{ clip.sample_to_pose(pose, time); }
+			);
+		}
+	);
+
+	bench::print_speedup("Clip + ClipCursor", search, cursor);
+	bench::print_speedup("FastClip", search, fast);
+	bench::print_speedup("PackedClip", search, packed);
+}
+
+BENCHMARK("track sampling 2000 keys")
+{
+	std::vector<VectorFrame> frames;
+	for (int i = 0; i < 2000; ++i)
+	{
+		const auto value = vec3(static_cast<float>(i % 7), 0.0f, static_cast<float>(i % 3));
+		frames.emplace_back(static_cast<float>(i) / 30.0f, vec3(), vec3(), value);
+	}
+	const auto track = VectorTrack{frames, Interpolation::Linear};
+	const auto fast_track = optimize_track(track);
+	const auto packed_track = pack_track(track);
+	const auto duration = track.get_end_time();
+
+	auto cursor = TrackCursor{};
+
+	const auto search = bench::measure(
+		"Track",
+		[&]()
+		{
+			for (float time = 0.0f; time < duration; time += 1.0f / SAMPLE_RATE)
+			{
+				bench::use(track.get_sample(time, true).x);
+			}
+		}
+	);
+	const auto with_cursor = bench::measure(
+		"Track + TrackCursor",
+		[&]()
+		{
+			for (float time = 0.0f; time < duration; time += 1.0f / SAMPLE_RATE)
+			{
+				bench::use(track.get_sample(time, true, cursor).x);
+			}
+		}
+	);
+	const auto fast = bench::measure(
+		"FastTrack",
+		[&]()
+		{
+			for (float time = 0.0f; time < duration; time += 1.0f / SAMPLE_RATE)
+			{
+				bench::use(fast_track.get_sample(time, true).x);
+			}
+		}
+	);
+
+	const auto packed = bench::measure(
+		"PackedTrack",
+		[&]()
+		{
+			for (float time = 0.0f; time < duration; time += 1.0f / SAMPLE_RATE)
+			{
+				bench::use(packed_track.get_sample(time, true).x);
+			}
+		}
+	);
+
+	bench::print_speedup("Track + TrackCursor", search, with_cursor);
+	bench::print_speedup("FastTrack", search, fast);
+	bench::print_speedup("PackedTrack", search, packed);
+}
+
+BENCHMARK("clip compression woman.gltf")
+{
+	const auto woman = load_woman_clips();
+
+	std::vector<CompressedClip> compressed_clips;
+	for (const auto& clip: woman.clips)
+	{
+		compressed_clips.emplace_back(compress_clip(clip));
+		const auto report
+			= make_compression_report(clip, compressed_clips.back(), woman.rest_pose);
+		std::cout << clip.name << ": " << to_string(report) << "\n";
+	}
+
+	auto pose = woman.rest_pose;
+
+	const auto search = bench::measure(
+		"Clip",
+		[&]()
+		{
+			play_clips(
+				woman.clips,
+				pose,
+				[&](std::size_t, const Clip& clip, float time) { clip.sample_to_pose(pose, time); }
+			);
+		}
+	);
+	const auto compressed = bench::measure(
+		"CompressedClip",
+		[&]()
+		{
+			play_clips(
+				compressed_clips,
+				pose,
+				[&](std::size_t, const CompressedClip& clip, float time)
+				{ clip.sample_to_pose(pose, time); }
+			);
+		}
+	);
+
+	bench::print_speedup("CompressedClip", search, compressed);
+}
+
+BENCHMARK("key reduction woman.gltf")
+{
+	const auto woman = load_woman_clips();
+
+	auto reduced_clips = woman.clips;
+	for (auto& clip: reduced_clips)
+	{
+		const auto report = reduce_keys(clip, KeyReductionTolerance{});
+		std::cout << clip.name << ":\n" << to_string(report);
+	}
+
+	auto pose = woman.rest_pose;
+
+	const auto search = bench::measure(
+		"Clip",
+		[&]()
+		{
+			play_clips(
+				woman.clips,
+				pose,
+				[&](std::size_t, const Clip& clip, float time) { clip.sample_to_pose(pose, time); }
+			);
+		}
+	);
+	const auto reduced = bench::measure(
+		"Clip with reduced keys",
+		[&]()
+		{
+			play_clips(
+				reduced_clips,
+				pose,
+				[&](std::size_t, const Clip& clip, float time) { clip.sample_to_pose(pose, time); }
+			);
+		}
+	);
+
+	bench::print_speedup("Clip with reduced keys", search, reduced);
+}
+
+BENCHMARK("crowd sampling woman.gltf")
+{
+	constexpr std::size_t NUMBER_OF_INSTANCES = 2000;
+	const auto woman = load_woman_clips();
+
+	std::vector<ClipInstance> instances;
+	for (std::size_t index = 0; index < NUMBER_OF_INSTANCES; ++index)
+	{
+		const auto clip = index % woman.clips.size();
+		instances.emplace_back(ClipInstance{clip, static_cast<float>(index) * 0.0371f});
+	}
+	auto poses = std::vector<Pose>(instances.size(), woman.rest_pose);
+
+	const auto single = bench::measure(
+		"sample_to_pose per instance",
+		[&]()
+		{
+			for (std::size_t index = 0; index < instances.size(); ++index)
+			{
+				const auto& instance = instances[index];
+				woman.clips[instance.clip].sample_to_pose(poses[index], instance.time);
+			}
+			bench::use(poses[0][0].local.position.x);
+		}
+	);
+
+	auto batch = PoseBatch<Clip>{};
+	const auto batched = bench::measure(
+		"PoseBatch",
+		[&]()
+		{
+			batch.prepare(woman.clips, instances);
+			batch.run(poses);
+			bench::use(poses[0][0].local.position.x);
+		}
+	);
+
+	bench::print_speedup("PoseBatch", single, batched);
+}
@@ -1,119 +1,37 @@
 #include "vita/anim/track.h"
 
+#include "vita/anim/tracksampling.h"
+
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 
-namespace linear_track_helpers
-{
-float inline interpolate(float a, float b, float t)
-{
-	return a + (b - a) * t;
-}
-
-vec3 inline interpolate(const vec3& a, const vec3& b, float t)
-{
-	return lerp(a, b, t);
-}
-
-quat inline interpolate(const quat& a, const quat& b, float t)
-{
-	return dot(a, b) < 0 ? nlerp(a, -b, t) : nlerp(a, b, t);
-}
-}  //  namespace linear_track_helpers
-
-namespace hermite_track_helpers
-{
-float inline adjust_hermite_result(float f)
-{
-	return f;
-}
-
-vec3 inline adjust_hermite_result(const vec3& v)
-{
-	return v;
-}
-
-quat inline adjust_hermite_result(const quat& q)
-{
-	return get_normalized(q);
-}
-
-float inline get_neighborhood(float, float rhs)
-{
-	return rhs;
-}
-
-const vec3 inline& get_neighborhood(const vec3&, const vec3& rhs)
-{
-	return rhs;
-}
-
-quat inline get_neighborhood(const quat& lhs, const quat& rhs)
-{
-	return dot(lhs, rhs) < 0 ? -rhs : rhs;
-}
-};	//  namespace hermite_track_helpers
-
+/// the last frame with a time less or equal to the given time, -1 if before the first frame
 template<typename T>
-T calc_hermite_interpolation(float t, const T& p1, const T& s1, const T& ap2, const T& s2)
+int search_frame_index(const Track<T>& track, float time)
 {
-	float tt = t * t;
-	float ttt = tt * t;
+	const auto& frames = track.frames;
 
-	const auto p2 = hermite_track_helpers::get_neighborhood(p1, ap2);
-
-	float h1 = 2.0f * ttt - 3.0f * tt + 1.0f;
-	float h2 = -2.0f * ttt + 3.0f * tt;
-	float h3 = ttt - 2.0f * tt + t;
-	float h4 = ttt - tt;
-
-	T result = p1 * h1 + p2 * h2 + s1 * h3 + s2 * h4;
-	return hermite_track_helpers::adjust_hermite_result(result);
-}
-
-template<typename T>
-int find_frame_index(const Track<T>& track, float time, bool looping)
-{
-	if (track.is_valid() == false)
+	// also catches nan
+	if ((time >= frames[0].time) == false)
 	{
 		return -1;
 	}
 
-	const auto number_of_frames = track.frames.size();
-	if (looping)
-	{
-		const auto start_time = track.frames[0].time;
-		const auto end_time = track.frames[number_of_frames - 1].time;
-
-		time = std::fmod(time - start_time, end_time - start_time);
-		if (time < 0.0f)
-		{
-			time += end_time - start_time;
-		}
-		time = time + start_time;
-	}
-	else
-	{
-		if (time <= track.frames[0].time)
-		{
-			return 0;
-		}
-		if (time >= track.frames[number_of_frames - 2].time)
-		{
-			return static_cast<int>(number_of_frames) - 2;
-		}
-	}
-
-	for (int i = static_cast<int>(number_of_frames) - 1; i >= 0; --i)
-	{
-		if (time >= track.frames[static_cast<unsigned int>(i)].time)
-		{
-			return i;
-		}
-	}
+	const auto found = std::upper_bound(
+		frames.begin(),
+		frames.end(),
+		time,
+		[](float lhs, const Frame<T>& rhs) { return lhs < rhs.time; }
+	);
+	return static_cast<int>(found - frames.begin()) - 1;
+}
 
-	// Invalid code, we should not reach here!
-	return -1;
+/// the time of a frame, for the shared key searches
+template<typename T>
+auto get_frame_times(const Track<T>& track)
+{
+	return [&track](int index) { return track.frames[static_cast<std::size_t>(index)].time; };
 }
 
 template<typename T>
@@ -124,56 +42,58 @@ float adjust_time_to_fit_track(const Track<T>& track, float time, bool looping)
 		return 0.0f;
 	}
 
-	const auto number_of_frames = static_cast<unsigned int>(track.frames.size());
-	const auto start_time = track.frames[0].time;
-	const auto end_time = track.frames[number_of_frames - 1].time;
-	const auto duration = end_time - start_time;
-	if (duration <= 0.0f)
-	{
-		return 0.0f;
-	}
-	if (looping)
-	{
-		auto ret = std::fmod(time - start_time, duration);
-		if (ret < 0.0f)
+	return adjust_time_to_fit_range(
+		track.frames[0].time, track.frames[track.frames.size() - 1].time, time, looping
+	);
+}
+
+/// same as Track<T>::get_frame_index but the search starts at the cursor, which is moved to the
+/// frame found
+template<typename T>
+int find_frame_index_from_cursor(
+	const Track<T>& track, float track_time, bool looping, TrackCursor& cursor
+)
+{
+	const auto number_of_frames = static_cast<int>(track.frames.size());
+	const auto frame_times = get_frame_times(track);
+	const auto index = find_key_index(
+		number_of_frames,
+		track_time,
+		looping,
+		frame_times,
+		[&](float t)
 		{
-			ret += duration;
+			return search_key_from_cursor(
+				number_of_frames,
+				t,
+				cursor.frame,
+				frame_times,
+				[&track](float time) { return search_frame_index(track, time); }
+			);
 		}
-		return ret + start_time;
-	}
-	else
+	);
+	if (index >= 0)
 	{
-		if (time <= start_time)
-		{
-			return start_time;
-		}
-		else if (time >= end_time)
-		{
-			return end_time;
-		}
-		else
-		{
-			return time;
-		}
+		cursor.frame = index;
 	}
+	return index;
 }
 
 template<typename T>
-T get_sample_constant(const Track<T>& track, float time, bool looping)
+T get_sample_constant(const Track<T>& track, int frame_index, float)
 {
-	int frame = find_frame_index(track, time, looping);
-	if (frame < 0 || frame >= static_cast<int>(track.frames.size()))
+	if (frame_index < 0 || frame_index >= static_cast<int>(track.frames.size()))
 	{
 		return T();
 	}
 
-	return track.frames[static_cast<unsigned int>(frame)].value;
+	return track.frames[static_cast<unsigned int>(frame_index)].value;
 }
 
 template<typename T>
-T get_sample_linear(const Track<T>& track, float time, bool looping)
+T get_sample_linear(const Track<T>& track, int frame_index, float track_time)
 {
-	const auto this_frame_index = find_frame_index(track, time, looping);
+	const auto this_frame_index = frame_index;
 	if (this_frame_index < 0 || this_frame_index >= static_cast<int>(track.frames.size() - 1))
 	{
 		return T();
@@ -182,7 +102,6 @@ T get_sample_linear(const Track<T>& track, float time, bool looping)
 	const auto& this_frame = track.frames[static_cast<unsigned int>(this_frame_index)];
 	const auto& next_frame = track.frames[static_cast<unsigned int>(next_frame_index)];
 
-	const auto track_time = adjust_time_to_fit_track(track, time, looping);
 	const auto frame_delta = next_frame.time - this_frame.time;
 	if (frame_delta <= 0.0f)
 	{
@@ -197,9 +116,9 @@ T get_sample_linear(const Track<T>& track, float time, bool looping)
 }
 
 template<typename T>
-T get_sample_cubic(const Track<T>& track, float time, bool looping)
+T get_sample_cubic(const Track<T>& track, int frame_index, float track_time)
 {
-	const auto this_frame_index = find_frame_index(track, time, looping);
+	const auto this_frame_index = frame_index;
 	if (this_frame_index < 0 || this_frame_index >= static_cast<int>(track.frames.size() - 1))
 	{
 		return T();
@@ -208,7 +127,6 @@ T get_sample_cubic(const Track<T>& track, float time, bool looping)
 	const auto& this_frame = track.frames[static_cast<unsigned int>(this_frame_index)];
 	const auto& next_frame = track.frames[static_cast<unsigned int>(next_frame_index)];
 
-	const auto track_time = adjust_time_to_fit_track(track, time, looping);
 	const auto frame_delta = next_frame.time - this_frame.time;
 	if (frame_delta <= 0.0f)
 	{
@@ -246,17 +164,56 @@ float Track<T>::get_end_time() const
 }
 
 template<typename T>
-T Track<T>::get_sample(float time, bool looping) const
+T sample_at_frame(const Track<T>& track, int frame_index, float track_time)
 {
-	switch (interpolation)
+	switch (track.interpolation)
 	{
 	default:
-	case Interpolation::Constant: return get_sample_constant(*this, time, looping);
-	case Interpolation::Linear: return get_sample_linear(*this, time, looping);
-	case Interpolation::Cubic: return get_sample_cubic(*this, time, looping);
+	case Interpolation::Constant: return get_sample_constant(track, frame_index, track_time);
+	case Interpolation::Linear: return get_sample_linear(track, frame_index, track_time);
+	case Interpolation::Cubic: return get_sample_cubic(track, frame_index, track_time);
 	}
 }
 
+template<typename T>
+T Track<T>::get_sample(float time, bool looping) const
+{
+	const auto track_time = adjust_time_to_fit_track(*this, time, looping);
+	return sample_at_frame(*this, get_frame_index(track_time, looping), track_time);
+}
+
+template<typename T>
+T Track<T>::get_sample(float time, bool looping, TrackCursor& cursor) const
+{
+	const auto track_time = adjust_time_to_fit_track(*this, time, looping);
+	const auto index = find_frame_index_from_cursor(*this, track_time, looping, cursor);
+	return sample_at_frame(*this, index, track_time);
+}
+
+template<typename T>
+float Track<T>::adjust_time_to_fit(float time, bool looping) const
+{
+	return adjust_time_to_fit_track(*this, time, looping);
+}
+
+template<typename T>
+int Track<T>::get_frame_index(float track_time, bool looping) const
+{
+	return find_key_index(
+		static_cast<int>(frames.size()),
+		track_time,
+		looping,
+		get_frame_times(*this),
+		[this](float t) { return search_frame_index(*this, t); }
+	);
+}
+
+template<typename T>
+T Track<T>::get_sample_at_frame(int frame_index, float track_time) const
+{
+	return sample_at_frame(*this, frame_index, track_time);
+}
+
 template<typename T>
 bool Track<T>::is_valid() const
 {
@@ -267,7 +224,16 @@ namespace for_testing
 {
 int find_frame_index_scalar(const ScalarTrack& track, float time, bool looping)
 {
-	return find_frame_index(track, time, looping);
+	return track.get_frame_index(track.adjust_time_to_fit(time, looping), looping);
+}
+
+int find_frame_index_scalar(
+	const ScalarTrack& track, float time, bool looping, TrackCursor& cursor
+)
+{
+	return find_frame_index_from_cursor(
+		track, track.adjust_time_to_fit(time, looping), looping, cursor
+	);
 }
 
 float adjust_time_to_fit_track_scalar(const ScalarTrack& track, float time, bool looping)
@@ -7,6 +7,12 @@
 #include "vita/anim/quat.h"
 #include "vita/anim/interpolation.h"
 
+/// remembers the frame of the last sample so playing a track forward doesn't need a full search
+struct TrackCursor
+{
+	int frame = 0;
+};
+
 template<typename T>
 struct Track
 {
@@ -20,6 +26,17 @@ struct Track
 	float get_start_time() const;
 	float get_end_time() const;
 	T get_sample(float time, bool looping) const;
+	T get_sample(float time, bool looping, TrackCursor& cursor) const;
+
+	/// loop or clamp the time to the track, the result is the track time used by the functions
+	/// below
+	float adjust_time_to_fit(float time, bool looping) const;
+
+	/// the frame before the track time
+	int get_frame_index(float track_time, bool looping) const;
+
+	/// sample using a frame index found by some external lookup
+	T get_sample_at_frame(int frame_index, float track_time) const;
 };
 
 typedef Track<float> ScalarTrack;
@@ -30,5 +47,8 @@ typedef Track<quat> QuaternionTrack;
 namespace for_testing
 {
 int find_frame_index_scalar(const ScalarTrack& track, float time, bool looping);
+int find_frame_index_scalar(
+	const ScalarTrack& track, float time, bool looping, TrackCursor& cursor
+);
 float adjust_time_to_fit_track_scalar(const ScalarTrack& track, float time, bool looping);
 }  //  namespace for_testing
@@ -1,6 +1,13 @@
 #include "catch.hpp"
 
 #include "vita/anim/track.h"
+#include "vita/anim/fasttrack.h"
+#include "vita/anim/packedtrack.h"
+#include "vita/anim/timesearch.h"
+#include "vita/anim/compressedtrack.h"
+#include "vita/anim/keyreduction.h"
+
+#include <cmath>
 
 using namespace for_testing;
 
@@ -44,3 +51,264 @@ TEST_CASE("track test")
 
 	// todo(Gustav): add test for float adjust_time_to_fit_track_scalar(const ScalarTrack& track, float time, bool looping);
 }
+
+TEST_CASE("track cursor")
+{
+	const auto looping = GENERATE(false, true);
+
+	std::vector<ScalarFrame> frames;
+	for (int i = 0; i < 100; i += 1)
+	{
+		frames.emplace_back(F(static_cast<float>(i) * 0.25f, 0));
+	}
+	const auto track = ScalarTrack{frames, Interpolation::Linear};
+
+	// playing forward, including looping around
+	auto cursor = TrackCursor{};
+	for (int i = -20; i < 500; i += 1)
+	{
+		const auto time = static_cast<float>(i) * 0.1f;
+		CHECK(
+			find_frame_index_scalar(track, time, looping)
+			== find_frame_index_scalar(track, time, looping, cursor)
+		);
+	}
+
+	// random seeks
+	for (const auto time : {20.0f, 3.0f, 24.5f, 0.0f, 11.1f, 11.2f, -3.0f, 100.0f, 7.7f})
+	{
+		CHECK(
+			find_frame_index_scalar(track, time, looping)
+			== find_frame_index_scalar(track, time, looping, cursor)
+		);
+	}
+
+	// a cursor from some other track
+	auto bad = TrackCursor{1000};
+	CHECK(
+		find_frame_index_scalar(track, 5.0f, looping)
+		== find_frame_index_scalar(track, 5.0f, looping, bad)
+	);
+}
+
+TEST_CASE("track sample with a cursor")
+{
+	const auto inter
+		= GENERATE(Interpolation::Constant, Interpolation::Linear, Interpolation::Cubic);
+	const auto looping = GENERATE(false, true);
+
+	std::vector<ScalarFrame> frames;
+	float time = 0.0f;
+	for (int i = 0; i < 50; i += 1)
+	{
+		const auto value = static_cast<float>(i % 5);
+		frames.emplace_back(time, value * 0.5f, value * -0.25f, value);
+		time += (i % 3 == 0) ? 0.001f : 0.3f;
+	}
+	const auto track = ScalarTrack{frames, inter};
+
+	// playing forward and looping around, then random seeks
+	auto cursor = TrackCursor{};
+	for (int i = -20; i < 1000; i += 1)
+	{
+		const auto t = static_cast<float>(i) * 0.0173f;
+		CHECK(track.get_sample(t, looping) == track.get_sample(t, looping, cursor));
+	}
+	for (const auto t: {10.0f, 1.0f, 14.5f, 0.0f, 5.1f, 5.2f, -3.0f, 100.0f})
+	{
+		CHECK(track.get_sample(t, looping) == track.get_sample(t, looping, cursor));
+	}
+
+	// a looping track without a duration
+	const auto flat = ScalarTrack{{F(1, 2), F(1, 3)}, inter};
+	auto flat_cursor = TrackCursor{};
+	CHECK(flat.get_sample(4.0f, looping) == flat.get_sample(4.0f, looping, flat_cursor));
+}
+
+TEST_CASE("fast track")
+{
+	const auto inter
+		= GENERATE(Interpolation::Constant, Interpolation::Linear, Interpolation::Cubic);
+	const auto looping = GENERATE(false, true);
+
+	// uneven spacing, some keys closer than the lookup sample rate
+	std::vector<ScalarFrame> frames;
+	float time = 0.0f;
+	for (int i = 0; i < 50; i += 1)
+	{
+		frames.emplace_back(F(time, static_cast<float>(i % 5)));
+		time += (i % 3 == 0) ? 0.001f : 0.3f;
+	}
+	const auto track = ScalarTrack{frames, inter};
+	const auto fast = optimize_track(track);
+
+	for (int i = -20; i < 1000; i += 1)
+	{
+		const auto t = static_cast<float>(i) * 0.0173f;
+		CHECK(track.get_sample(t, looping) == fast.get_sample(t, looping));
+	}
+
+	// a long gap followed by more keys than the table has samples for
+	std::vector<ScalarFrame> gap = {F(0, 1), F(1000, 2)};
+	for (int i = 0; i < 200; i += 1)
+	{
+		gap.emplace_back(F(1000.0f + static_cast<float>(i + 1) * 0.0001f, static_cast<float>(i)));
+	}
+	const auto gap_track = ScalarTrack{gap, inter};
+	const auto fast_gap = optimize_track(gap_track);
+	for (int i = -20; i < 1000; i += 1)
+	{
+		const auto t = 999.99f + static_cast<float>(i) * 0.00003f;
+		CHECK(gap_track.get_sample(t, looping) == fast_gap.get_sample(t, looping));
+	}
+	CHECK(gap_track.get_sample(500.0f, looping) == fast_gap.get_sample(500.0f, looping));
+}
+
+TEST_CASE("packed track")
+{
+	const auto inter
+		= GENERATE(Interpolation::Constant, Interpolation::Linear, Interpolation::Cubic);
+	const auto looping = GENERATE(false, true);
+
+	std::vector<ScalarFrame> frames;
+	float time = 0.0f;
+	for (int i = 0; i < 50; i += 1)
+	{
+		const auto value = static_cast<float>(i % 5);
+		frames.emplace_back(time, value * 0.5f, value * -0.25f, value);
+		time += (i % 3 == 0) ? 0.001f : 0.3f;
+	}
+	const auto track = ScalarTrack{frames, inter};
+	const auto packed = pack_track(track);
+
+	CHECK(packed.in_tangents.size() == (inter == Interpolation::Cubic ? frames.size() : 0));
+
+	auto cursor = TrackCursor{};
+	for (int i = -20; i < 1000; i += 1)
+	{
+		const auto t = static_cast<float>(i) * 0.0173f;
+		CHECK(track.get_sample(t, looping) == packed.get_sample(t, looping));
+		CHECK(track.get_sample(t, looping) == packed.get_sample(t, looping, cursor));
+	}
+}
+
+TEST_CASE("time search kernels")
+{
+	const auto kernel = GENERATE(cpu::Kernel::Scalar, cpu::Kernel::Sse, cpu::Kernel::Avx);
+	if (cpu::is_supported(kernel) == false)
+	{
+		return;
+	}
+
+	// odd sizes to hit the scalar tail, duplicated keys and longer than the simd window
+	for (std::size_t count = 0; count < 150; count += 7)
+	{
+		std::vector<float> times;
+		for (std::size_t i = 0; i < count; i += 1)
+		{
+			times.emplace_back(static_cast<float>(i / 3) * 0.25f);
+		}
+
+		for (int i = -10; i < 200; i += 1)
+		{
+			const auto t = static_cast<float>(i) * 0.0625f;
+			const auto expected = static_cast<int>(
+				std::upper_bound(times.begin(), times.end(), t) - times.begin()
+			) - 1;
+			CHECK(expected == time_search::find_index(times.data(), times.size(), t, kernel));
+		}
+		CHECK(-1 == time_search::find_index(times.data(), times.size(), std::nanf(""), kernel));
+	}
+}
+
+TEST_CASE("compressed track")
+{
+	const auto looping = GENERATE(false, true);
+
+	std::vector<QuaternionFrame> rotations;
+	std::vector<VectorFrame> positions;
+	for (int i = 0; i < 40; i += 1)
+	{
+		const auto time = static_cast<float>(i) * 0.1f;
+		const auto angle = static_cast<float>(i) * 0.7f;
+		const auto axis = get_normalized(vec3(1.0f, static_cast<float>(i % 3), -0.5f));
+		const auto rotation = quat_from_angle_axis(angle, axis);
+		const auto position = vec3(angle, -2.0f * angle, 10.0f);
+		rotations.emplace_back(time, quat(), quat(), i % 2 == 0 ? rotation : -rotation);
+		positions.emplace_back(time, vec3(), vec3(), position);
+	}
+	const auto rotation = QuaternionTrack{rotations, Interpolation::Linear};
+	const auto position = VectorTrack{positions, Interpolation::Linear};
+	const auto compressed_rotation = compress_track(rotation);
+	const auto compressed_position = compress_track(position);
+
+	for (std::size_t i = 0; i < rotations.size(); i += 1)
+	{
+		const auto q = get_normalized(rotations[i].value);
+		const auto decoded = compressed_rotation.get_value(i);
+		const auto angle = 2.0f * std::acos(std::min(1.0f, std::abs(dot(q, decoded))));
+		CHECK(angle <= compressed_rotation.get_error_bound() + 0.001f);
+
+		const auto error = get_length(positions[i].value - compressed_position.get_value(i));
+		CHECK(error <= compressed_position.get_error_bound() + 0.00001f);
+	}
+
+	// key times are moved by at most half of duration/65535 so sampling is close to the original
+	auto cursor = TrackCursor{};
+	for (int i = -20; i < 500; i += 1)
+	{
+		const auto t = static_cast<float>(i) * 0.0173f;
+		const auto expected = position.get_sample(t, looping);
+		CHECK(get_length(expected - compressed_position.get_sample(t, looping)) < 0.001f);
+		CHECK(get_length(expected - compressed_position.get_sample(t, looping, cursor)) < 0.001f);
+		const auto expected_rotation = rotation.get_sample(t, looping);
+		const auto sampled_rotation = compressed_rotation.get_sample(t, looping);
+		CHECK(std::abs(dot(expected_rotation, sampled_rotation)) > 0.9999f);
+	}
+	CHECK(compressed_position.get_memory_usage() * 4 < positions.size() * sizeof(VectorFrame));
+}
+
+TEST_CASE("key reduction")
+{
+	const auto inter = GENERATE(Interpolation::Linear, Interpolation::Cubic);
+
+	// a straight line with a bump in the middle
+	std::vector<VectorFrame> frames;
+	for (int i = 0; i <= 60; i += 1)
+	{
+		const auto time = static_cast<float>(i) / 30.0f;
+		const auto bump = i == 30 ? 1.0f : 0.0f;
+		const auto slope = vec3(2.0f, 0.0f, 0.0f);
+		frames.emplace_back(time, slope, slope, vec3(time * 2.0f, bump, 0.0f));
+	}
+	const auto original = VectorTrack{frames, inter};
+	auto reduced = original;
+
+	const auto tolerance = 0.01f;
+	const auto reduction = reduce_keys(reduced, tolerance);
+	CHECK(reduction.keys_before == 61);
+	CHECK(reduction.keys_after == reduced.frames.size());
+	CHECK(reduction.keys_after < 10);
+	CHECK(reduction.max_error <= tolerance);
+	CHECK(reduced.get_start_time() == original.get_start_time());
+	CHECK(reduced.get_end_time() == original.get_end_time());
+
+	for (int i = 0; i <= 200; i += 1)
+	{
+		const auto t = static_cast<float>(i) / 100.0f;
+		const auto error = original.get_sample(t, false) - reduced.get_sample(t, false);
+		CHECK(get_length_sq(error) <= tolerance * tolerance);
+	}
+
+	std::vector<QuaternionFrame> rotations;
+	for (int i = 0; i <= 60; i += 1)
+	{
+		const auto time = static_cast<float>(i) / 30.0f;
+		const auto rotation = quat_from_angle_axis(time, vec3(0.0f, 1.0f, 0.0f));
+		rotations.emplace_back(time, quat(), quat(), i % 2 == 0 ? rotation : -rotation);
+	}
+	auto rotation = QuaternionTrack{rotations, Interpolation::Linear};
+	const auto rotation_reduction = reduce_keys(rotation, 0.001f);
+	CHECK(rotation_reduction.keys_after < 10);
+	CHECK(rotation_reduction.max_error <= 0.001f);
+}
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "vita/anim/vec3.h"
+#include "vita/anim/quat.h"
+
+/// sampling code shared between the track storage types
+
+/// the number of frames a cursor is allowed to step forward before falling back to a search
+constexpr int CURSOR_MAX_STEPS = 4;
+
+/// the last key with a time less or equal to the given time, looking from the cursor first.
+/// Playback usually only moves forward a key or two from the last sample so this is mostly O(1),
+/// anything else goes to search. time_at(index) is the time of a key, in the same unit as time
+template<typename TimeAt, typename Search>
+int search_key_from_cursor(
+	int number_of_keys, float time, int cursor, TimeAt time_at, Search search
+)
+{
+	const auto last = number_of_keys - 1;
+
+	auto index = std::clamp(cursor, 0, last);
+	if (time >= time_at(index))
+	{
+		for (int step = 0; step < CURSOR_MAX_STEPS && index < last; ++step)
+		{
+			if (time < time_at(index + 1))
+			{
+				return index;
+			}
+			index += 1;
+		}
+
+		if (index == last || time < time_at(index + 1))
+		{
+			return index;
+		}
+	}
+
+	// random seek or we looped around
+	return search(time);
+}
+
+/// the key before a track time that has already been looped or clamped to the track, the guards
+/// every track type runs before search. -1 without two keys to interpolate between or for a
+/// looping track without a duration
+template<typename TimeAt, typename Search>
+int find_key_index(
+	int number_of_keys, float track_time, bool looping, TimeAt time_at, Search search
+)
+{
+	if (number_of_keys < 2)
+	{
+		return -1;
+	}
+
+	if (looping)
+	{
+		if (time_at(number_of_keys - 1) - time_at(0) <= 0.0f)
+		{
+			return -1;
+		}
+	}
+	else
+	{
+		if (track_time <= time_at(0))
+		{
+			return 0;
+		}
+		if (track_time >= time_at(number_of_keys - 2))
+		{
+			return number_of_keys - 2;
+		}
+	}
+
+	return search(track_time);
+}
+
+namespace linear_track_helpers
+{
+float inline interpolate(float a, float b, float t)
+{
+	return a + (b - a) * t;
+}
+
+vec3 inline interpolate(const vec3& a, const vec3& b, float t)
+{
+	return lerp(a, b, t);
+}
+
+quat inline interpolate(const quat& a, const quat& b, float t)
+{
+	return dot(a, b) < 0 ? nlerp(a, -b, t) : nlerp(a, b, t);
+}
+}  //  namespace linear_track_helpers
+
+namespace hermite_track_helpers
+{
+float inline adjust_hermite_result(float f)
+{
+	return f;
+}
+
+vec3 inline adjust_hermite_result(const vec3& v)
+{
+	return v;
+}
+
+quat inline adjust_hermite_result(const quat& q)
+{
+	return get_normalized(q);
+}
+
+float inline get_neighborhood(float, float rhs)
+{
+	return rhs;
+}
+
+const vec3 inline& get_neighborhood(const vec3&, const vec3& rhs)
+{
+	return rhs;
+}
+
+quat inline get_neighborhood(const quat& lhs, const quat& rhs)
+{
+	return dot(lhs, rhs) < 0 ? -rhs : rhs;
+}
+};	//  namespace hermite_track_helpers
+
+template<typename T>
+T calc_hermite_interpolation(float t, const T& p1, const T& s1, const T& ap2, const T& s2)
+{
+	float tt = t * t;
+	float ttt = tt * t;
+
+	const auto p2 = hermite_track_helpers::get_neighborhood(p1, ap2);
+
+	float h1 = 2.0f * ttt - 3.0f * tt + 1.0f;
+	float h2 = -2.0f * ttt + 3.0f * tt;
+	float h3 = ttt - 2.0f * tt + t;
+	float h4 = ttt - tt;
+
+	T result = p1 * h1 + p2 * h2 + s1 * h3 + s2 * h4;
+	return hermite_track_helpers::adjust_hermite_result(result);
+}
+
+/// loop or clamp a time to the start and end of a track
+inline float adjust_time_to_fit_range(float start_time, float end_time, float time, bool looping)
+{
+	const auto duration = end_time - start_time;
+	if (duration <= 0.0f)
+	{
+		return 0.0f;
+	}
+	if (looping)
+	{
+		auto ret = std::fmod(time - start_time, duration);
+		if (ret < 0.0f)
+		{
+			ret += duration;
+		}
+		return ret + start_time;
+	}
+	else
+	{
+		if (time <= start_time)
+		{
+			return start_time;
+		}
+		else if (time >= end_time)
+		{
+			return end_time;
+		}
+		else
+		{
+			return time;
+		}
+	}
+}
@@ -3,33 +3,6 @@
 
 #include "vita/anim/transform.h"
 
-Transform::Transform()
-	: position(vec3(0, 0, 0))
-	, rotation(quat(0, 0, 0, 1))
-	, scale(vec3(1, 1, 1))
-{
-}
-
-Transform::Transform(const vec3& p, const quat& r, const vec3& s)
-	: position(p)
-	, rotation(r)
-	, scale(s)
-{
-}
-
-Transform get_combined(const Transform& a, const Transform& b)
-{
-	Transform out;
-
-	out.scale = a.scale * b.scale;
-	out.rotation = b.rotation * a.rotation;
-
-	out.position = a.rotation * (a.scale * b.position);
-	out.position = a.position + out.position;
-
-	return out;
-}
-
 Transform get_inverse(const Transform& t)
 {
 	Transform inv;
@@ -46,18 +19,6 @@ Transform get_inverse(const Transform& t)
 	return inv;
 }
 
-Transform get_mixed(const Transform& a, const Transform& b, float t)
-{
-	quat bRot = b.rotation;
-	if (dot(a.rotation, bRot) < 0.0f)
-	{
-		bRot = -bRot;
-	}
-	return Transform(
-		lerp(a.position, b.position, t), nlerp(a.rotation, bRot, t), lerp(a.scale, b.scale, t)
-	);
-}
-
 bool operator==(const Transform& a, const Transform& b)
 {
 	return a.position == b.position && a.rotation == b.rotation && a.scale == b.scale;
@@ -68,42 +29,6 @@ bool operator!=(const Transform& a, const Transform& b)
 	return ! (a == b);
 }
 
-mat4 mat4_from_transform(const Transform& t)
-{
-	// First, extract the rotation basis of the transform
-	vec3 x = t.rotation * vec3(1, 0, 0);
-	vec3 y = t.rotation * vec3(0, 1, 0);
-	vec3 z = t.rotation * vec3(0, 0, 1);
-
-	// Next, scale the basis vectors
-	x = x * t.scale.x;
-	y = y * t.scale.y;
-	z = z * t.scale.z;
-
-	// Extract the position of the transform
-	const auto p = t.position;
-
-	// Create matrix
-	return mat4(
-		x.x,
-		x.y,
-		x.z,
-		0,	// X basis (& Scale)
-		y.x,
-		y.y,
-		y.z,
-		0,	// Y basis (& scale)
-		z.x,
-		z.y,
-		z.z,
-		0,	// Z basis (& scale)
-		p.x,
-		p.y,
-		p.z,
-		1  // Position
-	);
-}
-
 Transform transform_from_mat4(const mat4& m)
 {
 	Transform out;
@@ -119,16 +44,3 @@ Transform transform_from_mat4(const mat4& m)
 
 	return out;
 }
-
-vec3 get_transformed_point(const Transform& a, const vec3& b)
-{
-	vec3 out = a.rotation * (a.scale * b);
-	out = a.position + out;
-
-	return out;
-}
-
-vec3 get_transformed_vector(const Transform& a, const vec3& b)
-{
-	return a.rotation * (a.scale * b);
-}
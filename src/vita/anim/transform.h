@@ -10,19 +10,60 @@ struct Transform
 	quat rotation;
 	vec3 scale;
 
-	Transform();
-	Transform(const vec3& p, const quat& r, const vec3& s);
+	constexpr Transform()
+		: position(vec3(0, 0, 0))
+		, rotation(quat(0, 0, 0, 1))
+		, scale(vec3(1, 1, 1))
+	{
+	}
+
+	constexpr Transform(const vec3& p, const quat& r, const vec3& s)
+		: position(p)
+		, rotation(r)
+		, scale(s)
+	{
+	}
 };
 
 bool operator==(const Transform& a, const Transform& b);
 bool operator!=(const Transform& a, const Transform& b);
 
-Transform get_combined(const Transform& a, const Transform& b);
+/// inline since combining and mixing run for every joint when sampling and building palettes
+constexpr Transform get_combined(const Transform& a, const Transform& b)
+{
+	return Transform(
+		a.position + a.rotation * (a.scale * b.position), b.rotation * a.rotation, a.scale * b.scale
+	);
+}
+
 Transform get_inverse(const Transform& t);
-Transform get_mixed(const Transform& a, const Transform& b, float t);
 
-vec3 get_transformed_point(const Transform& a, const vec3& b);
-vec3 get_transformed_vector(const Transform& a, const vec3& b);
+inline Transform get_mixed(const Transform& a, const Transform& b, float t)
+{
+	const auto b_rotation = dot(a.rotation, b.rotation) < 0.0f ? -b.rotation : b.rotation;
+	return Transform(
+		lerp(a.position, b.position, t), nlerp(a.rotation, b_rotation, t), lerp(a.scale, b.scale, t)
+	);
+}
+
+constexpr vec3 get_transformed_point(const Transform& a, const vec3& b)
+{
+	return a.position + a.rotation * (a.scale * b);
+}
+
+constexpr vec3 get_transformed_vector(const Transform& a, const vec3& b)
+{
+	return a.rotation * (a.scale * b);
+}
+
+constexpr mat4 mat4_from_transform(const Transform& t)
+{
+	// the rotated and scaled basis vectors, then the position
+	const auto x = t.rotation * vec3(1, 0, 0) * t.scale.x;
+	const auto y = t.rotation * vec3(0, 1, 0) * t.scale.y;
+	const auto z = t.rotation * vec3(0, 0, 1) * t.scale.z;
+	const auto& p = t.position;
+	return mat4(x.x, x.y, x.z, 0, y.x, y.y, y.z, 0, z.x, z.y, z.z, 0, p.x, p.y, p.z, 1);
+}
 
-mat4 mat4_from_transform(const Transform& t);
 Transform transform_from_mat4(const mat4& m);
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "vita/anim/transformtrack.h"
 
-TransformTrack::TransformTrack()
+template<typename VTRACK, typename QTRACK>
+TTransformTrack<VTRACK, QTRACK>::TTransformTrack()
 	: id(0)
 	, position{{}, Interpolation::Linear}
 	, rotation{{}, Interpolation::Linear}
@@ -8,7 +9,8 @@ TransformTrack::TransformTrack()
 {
 }
 
-bool TransformTrack::is_valid() const
+template<typename VTRACK, typename QTRACK>
+bool TTransformTrack<VTRACK, QTRACK>::is_valid() const
 {
 	return position.is_valid() || rotation.is_valid() || scale.is_valid();
 }
@@ -23,7 +25,8 @@ float max(const std::optional<float>& lhs, float rhs)
 	return lhs ? std::max(*lhs, rhs) : rhs;
 }
 
-float TransformTrack::get_start_time() const
+template<typename VTRACK, typename QTRACK>
+float TTransformTrack<VTRACK, QTRACK>::get_start_time() const
 {
 	std::optional<float> result = std::nullopt;
 
@@ -45,7 +48,8 @@ float TransformTrack::get_start_time() const
 	return result.value_or(0.0f);
 }
 
-float TransformTrack::get_end_time() const
+template<typename VTRACK, typename QTRACK>
+float TTransformTrack<VTRACK, QTRACK>::get_end_time() const
 {
 	std::optional<float> result = std::nullopt;
 
@@ -67,7 +71,10 @@ float TransformTrack::get_end_time() const
 	return result.value_or(0.0f);
 }
 
-Transform TransformTrack::get_sample(const Transform& ref, float time, bool looping) const
+template<typename VTRACK, typename QTRACK>
+Transform TTransformTrack<VTRACK, QTRACK>::get_sample(
+	const Transform& ref, float time, bool looping
+) const
 {
 	return {
 		position.is_valid() ? position.get_sample(time, looping) : ref.position,
@@ -75,3 +82,56 @@ Transform TransformTrack::get_sample(const Transform& ref, float time, bool loop
 		scale.is_valid() ? scale.get_sample(time, looping) : ref.scale
 	};
 }
+
+template<typename VTRACK, typename QTRACK>
+Transform TTransformTrack<VTRACK, QTRACK>::get_sample(
+	const Transform& ref, float time, bool looping, TransformTrackCursor& cursor
+) const
+{
+	return {
+		position.is_valid() ? position.get_sample(time, looping, cursor.position) : ref.position,
+		rotation.is_valid() ? rotation.get_sample(time, looping, cursor.rotation) : ref.rotation,
+		scale.is_valid() ? scale.get_sample(time, looping, cursor.scale) : ref.scale
+	};
+}
+
+FastTransformTrack optimize_transform_track(const TransformTrack& track)
+{
+	FastTransformTrack result;
+
+	result.id = track.id;
+	result.position = optimize_track(track.position);
+	result.rotation = optimize_track(track.rotation);
+	result.scale = optimize_track(track.scale);
+
+	return result;
+}
+
+PackedTransformTrack pack_transform_track(const TransformTrack& track)
+{
+	PackedTransformTrack result;
+
+	result.id = track.id;
+	result.position = pack_track(track.position);
+	result.rotation = pack_track(track.rotation);
+	result.scale = pack_track(track.scale);
+
+	return result;
+}
+
+CompressedTransformTrack compress_transform_track(const TransformTrack& track)
+{
+	CompressedTransformTrack result;
+
+	result.id = track.id;
+	result.position = compress_track(track.position);
+	result.rotation = compress_track(track.rotation);
+	result.scale = compress_track(track.scale);
+
+	return result;
+}
+
+template struct TTransformTrack<VectorTrack, QuaternionTrack>;
+template struct TTransformTrack<FastVectorTrack, FastQuaternionTrack>;
+template struct TTransformTrack<PackedVectorTrack, PackedQuaternionTrack>;
+template struct TTransformTrack<CompressedVectorTrack, CompressedQuaternionTrack>;
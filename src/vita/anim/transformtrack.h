@@ -1,17 +1,28 @@
 #pragma once
 
 #include "vita/anim/track.h"
+#include "vita/anim/fasttrack.h"
+#include "vita/anim/packedtrack.h"
+#include "vita/anim/compressedtrack.h"
 #include "vita/anim/transform.h"
 
-struct TransformTrack
+struct TransformTrackCursor
+{
+	TrackCursor position;
+	TrackCursor rotation;
+	TrackCursor scale;
+};
+
+template<typename VTRACK, typename QTRACK>
+struct TTransformTrack
 {
 	std::size_t id;
 
-	VectorTrack position;
-	QuaternionTrack rotation;
-	VectorTrack scale;
+	VTRACK position;
+	QTRACK rotation;
+	VTRACK scale;
 
-	TransformTrack();
+	TTransformTrack();
 
 	float get_start_time() const;
 	float get_end_time() const;
@@ -19,4 +30,17 @@ struct TransformTrack
 	bool is_valid() const;
 
 	Transform get_sample(const Transform& ref, float time, bool looping) const;
+	Transform get_sample(
+		const Transform& ref, float time, bool looping, TransformTrackCursor& cursor
+	) const;
 };
+
+typedef TTransformTrack<VectorTrack, QuaternionTrack> TransformTrack;
+typedef TTransformTrack<FastVectorTrack, FastQuaternionTrack> FastTransformTrack;
+typedef TTransformTrack<PackedVectorTrack, PackedQuaternionTrack> PackedTransformTrack;
+typedef TTransformTrack<CompressedVectorTrack, CompressedQuaternionTrack>
+	CompressedTransformTrack;
+
+FastTransformTrack optimize_transform_track(const TransformTrack& track);
+PackedTransformTrack pack_transform_track(const TransformTrack& track);
+CompressedTransformTrack compress_transform_track(const TransformTrack& track);
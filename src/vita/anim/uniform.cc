@@ -5,12 +5,15 @@
 #include "vita/anim/vec4.h"
 #include "vita/anim/quat.h"
 #include "vita/anim/mat4.h"
+#include "vita/anim/dualquaternion.h"
+#include "vita/glstate.h"
 
 #define UNIFORM_IMPL(gl_func, tType, dType) \
 	template<> \
 	void Uniform<tType>::Set(int slot, const tType* data, unsigned int length) \
 	{ \
 		gl_func(slot, static_cast<GLsizei>(length), static_cast<const dType*>(&data[0])); \
+		glstate::count_calls(1); \
 	}
 UNIFORM_IMPL(glUniform1iv, int, int)
 UNIFORM_IMPL(glUniform1fv, float, float)
@@ -21,6 +24,7 @@ UNIFORM_IMPL(glUniform1fv, float, float)
 	void Uniform<tType>::Set(int slot, const tType* data, unsigned int length) \
 	{ \
 		gl_func(slot, static_cast<GLsizei>(length), data->data_ptr()); \
+		glstate::count_calls(1); \
 	}
 UNIFORM_IMPL(glUniform4iv, ivec4, int)
 UNIFORM_IMPL(glUniform2iv, ivec2, int)
@@ -34,6 +38,17 @@ template<>
 void Uniform<mat4>::Set(int slot, const mat4* inputArray, unsigned int arrayLength)
 {
 	glUniformMatrix4fv(slot, static_cast<GLsizei>(arrayLength), false, inputArray->data_ptr());
+	glstate::count_calls(1);
+}
+
+/// a mat2x4 in the shader, the real part is the first column
+template<>
+void Uniform<DualQuaternion>::Set(
+	int slot, const DualQuaternion* inputArray, unsigned int arrayLength
+)
+{
+	glUniformMatrix2x4fv(slot, static_cast<GLsizei>(arrayLength), false, inputArray->data_ptr());
+	glstate::count_calls(1);
 }
 
 template<typename T>
@@ -57,3 +72,4 @@ template struct Uniform<vec3>;
 template struct Uniform<vec4>;
 template struct Uniform<quat>;
 template struct Uniform<mat4>;
+template struct Uniform<DualQuaternion>;
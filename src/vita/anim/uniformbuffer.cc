@@ -0,0 +1,101 @@
+#include "vita/anim/uniformbuffer.h"
+
+#include "vita/assert.h"
+#include "vita/glstate.h"
+
+#include <cstring>
+
+UniformBuffer::UniformBuffer()
+	: handle(0)
+	, size(0)
+{
+	glGenBuffers(1, &handle);
+}
+
+UniformBuffer::~UniformBuffer()
+{
+	glstate::invalidate();
+	glDeleteBuffers(1, &handle);
+}
+
+void UniformBuffer::set(const void* data, std::size_t size_in_bytes)
+{
+	size = size_in_bytes;
+
+	glBindBuffer(GL_UNIFORM_BUFFER, handle);
+	glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(size), data, GL_STREAM_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	glstate::count_calls(3);
+}
+
+void UniformBuffer::bind_to(unsigned int binding)
+{
+	glBindBufferBase(GL_UNIFORM_BUFFER, binding, handle);
+	glstate::count_calls(1);
+}
+
+void UniformBuffer::bind_range_to(
+	unsigned int binding, std::size_t offset, std::size_t size_in_bytes
+)
+{
+	ASSERT(offset + size_in_bytes <= size);
+	glBindBufferRange(
+		GL_UNIFORM_BUFFER,
+		binding,
+		handle,
+		static_cast<GLintptr>(offset),
+		static_cast<GLsizeiptr>(size_in_bytes)
+	);
+	glstate::count_calls(1);
+}
+
+std::size_t get_uniform_buffer_offset_alignment()
+{
+	GLint alignment = 0;
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+	return static_cast<std::size_t>(std::max(alignment, 1));
+}
+
+PaletteBuffer::PaletteBuffer(std::size_t max_joints)
+{
+	const auto alignment = get_uniform_buffer_offset_alignment();
+	const auto palette_size = max_joints * sizeof(mat4);
+	stride = ((palette_size + alignment - 1) / alignment) * alignment;
+}
+
+void PaletteBuffer::resize(std::size_t number_of_palettes)
+{
+	data.resize(number_of_palettes * stride);
+}
+
+std::size_t PaletteBuffer::get_number_of_palettes() const
+{
+	return data.size() / stride;
+}
+
+void PaletteBuffer::set_palette(std::size_t index, const std::vector<mat4>& palette)
+{
+	ASSERT(index < get_number_of_palettes());
+	ASSERT(palette.size() * sizeof(mat4) <= stride);
+	std::memcpy(data.data() + index * stride, palette.data(), palette.size() * sizeof(mat4));
+}
+
+void PaletteBuffer::set_palette(std::size_t index, const std::vector<affine3x4>& palette)
+{
+	ASSERT(index < get_number_of_palettes());
+	ASSERT(palette.size() * sizeof(affine3x4) <= stride);
+	std::memcpy(
+		data.data() + index * stride, palette.data(), palette.size() * sizeof(affine3x4)
+	);
+}
+
+void PaletteBuffer::upload()
+{
+	buffer.set(data.data(), data.size());
+}
+
+void PaletteBuffer::bind_palette(std::size_t index, unsigned int binding)
+{
+	ASSERT(index < get_number_of_palettes());
+	buffer.bind_range_to(binding, index * stride, stride);
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+
+#include "vita/anim/affine3x4.h"
+#include "vita/anim/mat4.h"
+
+/// a buffer the shaders read through a uniform block
+struct UniformBuffer
+{
+	unsigned int handle;
+	std::size_t size;
+
+	UniformBuffer();
+	~UniformBuffer();
+
+	UniformBuffer(const UniformBuffer& other) = delete;
+	void operator=(const UniformBuffer& other) = delete;
+	UniformBuffer(UniformBuffer&& other) = delete;
+	void operator=(UniformBuffer&& other) = delete;
+
+	void set(const void* data, std::size_t size_in_bytes);
+
+	void bind_to(unsigned int binding);
+
+	/// only the part starting at offset, the offset must be a multiple of
+	/// get_uniform_buffer_offset_alignment
+	void bind_range_to(unsigned int binding, std::size_t offset, std::size_t size_in_bytes);
+};
+
+/// GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+std::size_t get_uniform_buffer_offset_alignment();
+
+/// the largest palette every GL 3.3 driver can bind, 16 kb of mat4
+constexpr std::size_t MAX_PALETTE_JOINTS = 256;
+
+/// an affine3x4 is a std140 mat3x4, 48 bytes, so an affine palette fits more joints in the space
+constexpr std::size_t MAX_AFFINE_PALETTE_JOINTS
+	= MAX_PALETTE_JOINTS * sizeof(mat4) / sizeof(affine3x4);
+static_assert(MAX_AFFINE_PALETTE_JOINTS == 341);
+
+/// the binding point the skin palette block of the shaders is connected to
+constexpr unsigned int SKIN_PALETTE_BINDING = 0;
+
+/// the skin palettes of many instances in a single uniform buffer, uploaded once and then bound
+/// per draw instead of uploading a uniform array for every draw
+struct PaletteBuffer
+{
+	UniformBuffer buffer;
+
+	/// bytes between two palettes, a palette rounded up to the offset alignment
+	std::size_t stride;
+
+	std::vector<unsigned char> data;
+
+	/// max_joints is the size of the array in the shader block
+	explicit PaletteBuffer(std::size_t max_joints = MAX_PALETTE_JOINTS);
+
+	/// make room for the palettes, keeps the memory between frames
+	void resize(std::size_t number_of_palettes);
+	std::size_t get_number_of_palettes() const;
+
+	void set_palette(std::size_t index, const std::vector<mat4>& palette);
+	/// for a shader block of mat3x4, the rows of the affine3x4 become the columns
+	void set_palette(std::size_t index, const std::vector<affine3x4>& palette);
+
+	/// one upload for all palettes
+	void upload();
+
+	void bind_palette(std::size_t index, unsigned int binding = SKIN_PALETTE_BINDING);
+};
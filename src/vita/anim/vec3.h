@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cassert>
+#include <cmath>
+#include <cstddef>
 
 constexpr float VEC3_EPSILON = 0.000001f;
 
@@ -12,7 +14,10 @@ struct vec3
 	float y;
 	float z;
 
-	const float* data_ptr() const;
+	constexpr const float* data_ptr() const
+	{
+		return &x;
+	}
 
 	float& operator[](std::size_t i)
 	{
@@ -25,34 +30,126 @@ struct vec3
 		}
 	}
 
-	vec3();
-	vec3(float ax, float ay, float az);
-	vec3(float* fv);
+	constexpr vec3()
+		: x(0.0f)
+		, y(0.0f)
+		, z(0.0f)
+	{
+	}
+
+	constexpr vec3(float ax, float ay, float az)
+		: x(ax)
+		, y(ay)
+		, z(az)
+	{
+	}
+
+	constexpr vec3(float* fv)
+		: x(fv[0])
+		, y(fv[1])
+		, z(fv[2])
+	{
+	}
 };
 
 static_assert(sizeof(vec3) == sizeof(float) * 3, "Invalid size");
 #pragma pack(pop)
 
-vec3 operator+(const vec3& l, const vec3& r);
-vec3 operator-(const vec3& l, const vec3& r);
-vec3 operator*(const vec3& v, float f);
-vec3 operator*(const vec3& l, const vec3& r);
-bool operator==(const vec3& l, const vec3& r);
-bool operator!=(const vec3& l, const vec3& r);
+// the trivial math is inline so hot loops don't pay a call per operation
+
+constexpr vec3 operator+(const vec3& l, const vec3& r)
+{
+	return vec3(l.x + r.x, l.y + r.y, l.z + r.z);
+}
+
+constexpr vec3 operator-(const vec3& l, const vec3& r)
+{
+	return vec3(l.x - r.x, l.y - r.y, l.z - r.z);
+}
+
+constexpr vec3 operator*(const vec3& v, float f)
+{
+	return vec3(v.x * f, v.y * f, v.z * f);
+}
+
+constexpr vec3 operator*(const vec3& l, const vec3& r)
+{
+	return vec3(l.x * r.x, l.y * r.y, l.z * r.z);
+}
+
+constexpr float dot(const vec3& l, const vec3& r)
+{
+	return l.x * r.x + l.y * r.y + l.z * r.z;
+}
+
+constexpr vec3 cross(const vec3& l, const vec3& r)
+{
+	return vec3(l.y * r.z - l.z * r.y, l.z * r.x - l.x * r.z, l.x * r.y - l.y * r.x);
+}
 
+constexpr float get_length_sq(const vec3& v)
+{
+	return v.x * v.x + v.y * v.y + v.z * v.z;
+}
+
+constexpr bool operator==(const vec3& l, const vec3& r)
+{
+	return get_length_sq(l - r) < VEC3_EPSILON;
+}
+
+constexpr bool operator!=(const vec3& l, const vec3& r)
+{
+	return ! (l == r);
+}
+
+inline float get_length(const vec3& v)
+{
+	const auto length_sq = get_length_sq(v);
+	if (length_sq < VEC3_EPSILON)
+	{
+		return 0.0f;
+	}
+	return sqrtf(length_sq);
+}
+
+inline void normalize(vec3& v)
+{
+	const auto length_sq = get_length_sq(v);
+	if (length_sq < VEC3_EPSILON)
+	{
+		return;
+	}
+
+	const auto length_inv = 1.0f / sqrtf(length_sq);
+	v.x *= length_inv;
+	v.y *= length_inv;
+	v.z *= length_inv;
+}
+
+inline vec3 get_normalized(const vec3& v)
+{
+	const auto length_sq = get_length_sq(v);
+	if (length_sq < VEC3_EPSILON)
+	{
+		return v;
+	}
+
+	const auto length_inv = 1.0f / sqrtf(length_sq);
+	return vec3(v.x * length_inv, v.y * length_inv, v.z * length_inv);
+}
+
+constexpr vec3 lerp(const vec3& s, const vec3& e, float t)
+{
+	return vec3(s.x + (e.x - s.x) * t, s.y + (e.y - s.y) * t, s.z + (e.z - s.z) * t);
+}
+
+inline vec3 nlerp(const vec3& s, const vec3& e, float t)
+{
+	return get_normalized(lerp(s, e, t));
+}
 
-float get_length_sq(const vec3& v);
-float get_length(const vec3& v);
-vec3 get_normalized(const vec3& v);
 float get_angle_between(const vec3& l, const vec3& r);
 vec3 get_projected(const vec3& a, const vec3& b);
 vec3 get_rejected(const vec3& a, const vec3& b);
 vec3 get_reflected(const vec3& a, const vec3& b);
-
-void normalize(vec3& v);
-
-float dot(const vec3& l, const vec3& r);
-vec3 cross(const vec3& l, const vec3& r);
-vec3 lerp(const vec3& s, const vec3& e, float t);
 vec3 slerp(const vec3& s, const vec3& e, float t);
-vec3 nlerp(const vec3& s, const vec3& e, float t);
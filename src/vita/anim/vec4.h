@@ -10,14 +10,14 @@ struct TVec4
 	T z;
 	T w;
 
-	const T* data_ptr() const
+	constexpr const T* data_ptr() const
 	{
 		return &x;
 	}
 
 	// T v[4];
 
-	TVec4<T>()
+	constexpr TVec4<T>()
 		: x(static_cast<T>(0))
 		, y(static_cast<T>(0))
 		, z(static_cast<T>(0))
@@ -25,7 +25,7 @@ struct TVec4
 	{
 	}
 
-	TVec4<T>(T _x, T _y, T _z, T _w)
+	constexpr TVec4<T>(T _x, T _y, T _z, T _w)
 		: x(_x)
 		, y(_y)
 		, z(_z)
@@ -33,7 +33,7 @@ struct TVec4
 	{
 	}
 
-	TVec4<T>(T* fv)
+	constexpr TVec4<T>(T* fv)
 		: x(fv[0])
 		, y(fv[1])
 		, z(fv[2])
@@ -0,0 +1,40 @@
+#include "vita/anim/vertexarray.h"
+
+#include "vita/glstate.h"
+
+#include <utility>
+
+VertexArray::VertexArray()
+	: handle(0)
+{
+	glGenVertexArrays(1, &handle);
+}
+
+VertexArray::~VertexArray()
+{
+	if (handle != 0)
+	{
+		glstate::invalidate();
+		glDeleteVertexArrays(1, &handle);
+	}
+}
+
+VertexArray::VertexArray(VertexArray&& other) noexcept
+	: handle(std::exchange(other.handle, 0))
+{
+}
+
+VertexArray& VertexArray::operator=(VertexArray&& other) noexcept
+{
+	if (this != &other)
+	{
+		VertexArray old{std::move(*this)};
+		handle = std::exchange(other.handle, 0);
+	}
+	return *this;
+}
+
+void VertexArray::bind()
+{
+	glstate::bind_vertex_array(handle);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+/// owns a vertex array object, moving it hands over the object
+struct VertexArray
+{
+	unsigned int handle;
+
+	VertexArray();
+	~VertexArray();
+
+	VertexArray(const VertexArray& other) = delete;
+	void operator=(const VertexArray& other) = delete;
+
+	VertexArray(VertexArray&& other) noexcept;
+	VertexArray& operator=(VertexArray&& other) noexcept;
+
+	void bind();
+};
@@ -3,6 +3,13 @@
 #include "lit.frag.h"
 #include "static.vert.h"
 #include "skinned.vert.h"
+#include "skinned_palette.vert.h"
+#include "skinned_palette_buffer.vert.h"
+#include "skinned_dual_quaternion.vert.h"
+#include "skinned_affine.vert.h"
+#include "skinned_crowd.vert.h"
+#include "skinned_baked.vert.h"
+#include "skinned_compact.vert.h"
 #include "uv.png.h"
 #include "woman.gltf.h"
 #include "woman.png.h"
@@ -20,6 +27,41 @@ ShaderSource skinned_shader()
 	return {std::string{SKINNED_VERT}};
 }
 
+ShaderSource skinned_palette_shader()
+{
+	return {std::string{SKINNED_PALETTE_VERT}};
+}
+
+ShaderSource skinned_palette_buffer_shader()
+{
+	return {std::string{SKINNED_PALETTE_BUFFER_VERT}};
+}
+
+ShaderSource skinned_dual_quaternion_shader()
+{
+	return {std::string{SKINNED_DUAL_QUATERNION_VERT}};
+}
+
+ShaderSource skinned_affine_shader()
+{
+	return {std::string{SKINNED_AFFINE_VERT}};
+}
+
+ShaderSource skinned_crowd_shader()
+{
+	return {std::string{SKINNED_CROWD_VERT}};
+}
+
+ShaderSource skinned_baked_shader()
+{
+	return {std::string{SKINNED_BAKED_VERT}};
+}
+
+ShaderSource skinned_compact_shader()
+{
+	return {std::string{SKINNED_COMPACT_VERT}};
+}
+
 ShaderSource lit_shader()
 {
 	return {std::string{LIT_FRAG}};
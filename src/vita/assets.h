@@ -10,6 +10,27 @@ ShaderSource static_shader();
 ShaderSource lit_shader();
 ShaderSource skinned_shader();
 
+/// skinned_shader but with a single precombined skin palette
+ShaderSource skinned_palette_shader();
+
+/// skinned_palette_shader reading the palette from a PaletteBuffer, up to 256 joints
+ShaderSource skinned_palette_buffer_shader();
+
+/// skinned_palette_shader with a dual quaternion palette, 8 floats per joint instead of 16
+ShaderSource skinned_dual_quaternion_shader();
+
+/// skinned_palette_shader with an affine3x4 palette, 12 floats per joint instead of 16
+ShaderSource skinned_affine_shader();
+
+/// skinned_palette_shader for CrowdRenderer, the palette and model come per instance
+ShaderSource skinned_crowd_shader();
+
+/// skinned_crowd_shader for BakedCrowdRenderer, the palette comes from a baked animation
+ShaderSource skinned_baked_shader();
+
+/// skinned_palette_buffer_shader for the interleaved vertices of a CompactMesh
+ShaderSource skinned_compact_shader();
+
 TextureData uv_texture();
 TextureData woman_texture();
 
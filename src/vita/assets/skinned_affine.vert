@@ -0,0 +1,38 @@
+#version 330 core
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+in vec3 position;
+in vec3 normal;
+in vec2 texCoord;
+in vec4 weights;
+in ivec4 joints;
+
+// pose * invBindPose without the bottom row, each column holds a row of the cpu affine3x4
+// a range of a PaletteBuffer, 48 bytes per joint fits 341 joints in the 16 kb of mat4 skin[256]
+layout(std140) uniform SkinPalette {
+    mat3x4 skin[341];
+};
+
+out vec3 norm;
+out vec3 fragPos;
+out vec2 uv;
+
+void main() {
+    mat3x4 m = skin[joints.x] * weights.x;
+    m += skin[joints.y] * weights.y;
+    m += skin[joints.z] * weights.z;
+    m += skin[joints.w] * weights.w;
+
+    // a row vector times the columns, the same as the affine matrix times the column vector
+    vec4 skinned = vec4(vec4(position, 1.0) * m, 1.0);
+    vec3 skinnedNormal = vec4(normal, 0.0) * m;
+
+    gl_Position = projection * view * model * skinned;
+
+    fragPos = vec3(model * skinned);
+    norm = vec3(model * vec4(skinnedNormal, 0.0f));
+    uv = texCoord;
+}
@@ -0,0 +1,56 @@
+#version 330 core
+
+uniform mat4 view;
+uniform mat4 projection;
+
+in vec3 position;
+in vec3 normal;
+in vec2 texCoord;
+in vec4 weights;
+in ivec4 joints;
+
+// one per instance
+in mat4 model;
+// the first row of the clip, the number of frames in the clip and the frame to sample
+in vec3 instance;
+
+// a BakedAnimation, one row per frame and 4 texels per joint
+uniform sampler2D palettes;
+
+out vec3 norm;
+out vec3 fragPos;
+out vec2 uv;
+
+mat4 getBakedSkin(int row, int joint) {
+    int texel = joint * 4;
+    return mat4(
+        texelFetch(palettes, ivec2(texel, row), 0),
+        texelFetch(palettes, ivec2(texel + 1, row), 0),
+        texelFetch(palettes, ivec2(texel + 2, row), 0),
+        texelFetch(palettes, ivec2(texel + 3, row), 0)
+    );
+}
+
+// linear between the two closest frames, close enough to the sampled pose at a high enough rate
+mat4 getSkin(int joint) {
+    float lastFrame = instance.y - 1.0;
+    float frame = clamp(instance.z, 0.0, lastFrame);
+    float first = floor(frame);
+    float t = frame - first;
+    int row = int(instance.x + first);
+    int nextRow = int(instance.x + min(first + 1.0, lastFrame));
+    return getBakedSkin(row, joint) * (1.0 - t) + getBakedSkin(nextRow, joint) * t;
+}
+
+void main() {
+    mat4 m = getSkin(joints.x) * weights.x;
+    m += getSkin(joints.y) * weights.y;
+    m += getSkin(joints.z) * weights.z;
+    m += getSkin(joints.w) * weights.w;
+
+    gl_Position = projection * view * model * m * vec4(position, 1.0);
+
+    fragPos = vec3(model * m * vec4(position, 1.0));
+    norm = vec3(model * m * vec4(normal, 0.0f));
+    uv = texCoord;
+}
@@ -0,0 +1,42 @@
+#version 330 core
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+// the locations CompactMesh set up its vertex array for
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec2 normal;
+layout(location = 2) in vec2 texCoord;
+layout(location = 3) in vec4 weights;
+layout(location = 4) in uvec4 joints;
+
+layout(std140) uniform SkinPalette {
+    mat4 skin[256];
+};
+
+out vec3 norm;
+out vec3 fragPos;
+out vec2 uv;
+
+// the inverse of encode_octahedral_normal
+vec3 decode_normal(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+void main() {
+    mat4 m = skin[joints.x] * weights.x;
+    m += skin[joints.y] * weights.y;
+    m += skin[joints.z] * weights.z;
+    m += skin[joints.w] * weights.w;
+
+    gl_Position = projection * view * model * m * vec4(position, 1.0);
+    
+    fragPos = vec3(model * m * vec4(position, 1.0));
+    norm = vec3(model * m * vec4(decode_normal(normal), 0.0f));
+    uv = texCoord;
+}
@@ -0,0 +1,44 @@
+#version 330 core
+
+uniform mat4 view;
+uniform mat4 projection;
+
+in vec3 position;
+in vec3 normal;
+in vec2 texCoord;
+in vec4 weights;
+in ivec4 joints;
+
+// one per instance
+in mat4 model;
+
+// the skin palettes of all instances after each other, 4 texels per matrix
+uniform samplerBuffer palettes;
+uniform int numberOfJoints;
+
+out vec3 norm;
+out vec3 fragPos;
+out vec2 uv;
+
+mat4 getSkin(int joint) {
+    int texel = (gl_InstanceID * numberOfJoints + joint) * 4;
+    return mat4(
+        texelFetch(palettes, texel),
+        texelFetch(palettes, texel + 1),
+        texelFetch(palettes, texel + 2),
+        texelFetch(palettes, texel + 3)
+    );
+}
+
+void main() {
+    mat4 m = getSkin(joints.x) * weights.x;
+    m += getSkin(joints.y) * weights.y;
+    m += getSkin(joints.z) * weights.z;
+    m += getSkin(joints.w) * weights.w;
+
+    gl_Position = projection * view * model * m * vec4(position, 1.0);
+
+    fragPos = vec3(model * m * vec4(position, 1.0));
+    norm = vec3(model * m * vec4(normal, 0.0f));
+    uv = texCoord;
+}
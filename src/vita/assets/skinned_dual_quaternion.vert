@@ -0,0 +1,65 @@
+#version 330 core
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+in vec3 position;
+in vec3 normal;
+in vec2 texCoord;
+in vec4 weights;
+in ivec4 joints;
+
+// invBindPose followed by the pose, real part in the first column
+// 8 floats per joint so this fits in the same space as mat4 skin[120]
+uniform mat2x4 skin[240];
+
+out vec3 norm;
+out vec3 fragPos;
+out vec2 uv;
+
+// same order as quat operator* on the cpu
+vec4 mulQ(vec4 Q1, vec4 Q2) {
+    return vec4(
+        Q2.x * Q1.w + Q2.y * Q1.z - Q2.z * Q1.y + Q2.w * Q1.x,
+        -Q2.x * Q1.z + Q2.y * Q1.w + Q2.z * Q1.x + Q2.w * Q1.y,
+        Q2.x * Q1.y - Q2.y * Q1.x + Q2.z * Q1.w + Q2.w * Q1.z,
+        -Q2.x * Q1.x - Q2.y * Q1.y - Q2.z * Q1.z + Q2.w * Q1.w
+    );
+}
+
+vec3 rotate(vec4 q, vec3 v) {
+    return q.xyz * 2.0 * dot(q.xyz, v)
+        + v * (q.w * q.w - dot(q.xyz, q.xyz))
+        + cross(q.xyz, v) * 2.0 * q.w;
+}
+
+vec3 transformPoint(mat2x4 dq, vec3 v) {
+    vec4 conjugate = vec4(-dq[0].xyz, dq[0].w);
+    vec4 t = mulQ(conjugate, dq[1] * 2.0);
+    return rotate(dq[0], v) + t.xyz;
+}
+
+void main() {
+    mat2x4 dq0 = skin[joints.x];
+    mat2x4 dq1 = skin[joints.y];
+    mat2x4 dq2 = skin[joints.z];
+    mat2x4 dq3 = skin[joints.w];
+
+    // q and -q are the same rotation, blend the one closest to the first influence
+    float w1 = dot(dq0[0], dq1[0]) < 0.0 ? -weights.y : weights.y;
+    float w2 = dot(dq0[0], dq2[0]) < 0.0 ? -weights.z : weights.z;
+    float w3 = dot(dq0[0], dq3[0]) < 0.0 ? -weights.w : weights.w;
+
+    mat2x4 dq = dq0 * weights.x + dq1 * w1 + dq2 * w2 + dq3 * w3;
+    dq /= length(dq[0]);
+
+    vec4 skinned = vec4(transformPoint(dq, position), 1.0);
+    vec3 skinnedNormal = rotate(dq[0], normal);
+
+    gl_Position = projection * view * model * skinned;
+
+    fragPos = vec3(model * skinned);
+    norm = vec3(model * vec4(skinnedNormal, 0.0f));
+    uv = texCoord;
+}
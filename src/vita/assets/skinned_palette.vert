@@ -0,0 +1,31 @@
+#version 330 core
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+in vec3 position;
+in vec3 normal;
+in vec2 texCoord;
+in vec4 weights;
+in ivec4 joints;
+
+// pose * invBindPose, combined on the cpu once per joint
+uniform mat4 skin[120];
+
+out vec3 norm;
+out vec3 fragPos;
+out vec2 uv;
+
+void main() {
+    mat4 m = skin[joints.x] * weights.x;
+    m += skin[joints.y] * weights.y;
+    m += skin[joints.z] * weights.z;
+    m += skin[joints.w] * weights.w;
+
+    gl_Position = projection * view * model * m * vec4(position, 1.0);
+    
+    fragPos = vec3(model * m * vec4(position, 1.0));
+    norm = vec3(model * m * vec4(normal, 0.0f));
+    uv = texCoord;
+}
@@ -0,0 +1,35 @@
+#version 330 core
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+in vec3 position;
+in vec3 normal;
+in vec2 texCoord;
+in vec4 weights;
+in ivec4 joints;
+
+// pose * invBindPose, combined on the cpu once per joint
+// a range of a PaletteBuffer instead of a uniform array, 256 joints is 16 kb which is the
+// smallest GL_MAX_UNIFORM_BLOCK_SIZE a driver can have
+layout(std140) uniform SkinPalette {
+    mat4 skin[256];
+};
+
+out vec3 norm;
+out vec3 fragPos;
+out vec2 uv;
+
+void main() {
+    mat4 m = skin[joints.x] * weights.x;
+    m += skin[joints.y] * weights.y;
+    m += skin[joints.z] * weights.z;
+    m += skin[joints.w] * weights.w;
+
+    gl_Position = projection * view * model * m * vec4(position, 1.0);
+    
+    fragPos = vec3(model * m * vec4(position, 1.0));
+    norm = vec3(model * m * vec4(normal, 0.0f));
+    uv = texCoord;
+}
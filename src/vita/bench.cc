@@ -0,0 +1,96 @@
+#include "vita/bench.h"
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+
+namespace bench
+{
+namespace
+{
+struct Benchmark
+{
+	std::string name;
+	BenchmarkFunction function;
+};
+
+std::vector<Benchmark>& all_benchmarks()
+{
+	static std::vector<Benchmark> benchmarks;
+	return benchmarks;
+}
+
+volatile float sink = 0.0f;
+
+constexpr double MIN_MEASURE_SECONDS = 0.25;
+}  //  namespace
+
+Registrar::Registrar(const char* name, BenchmarkFunction function)
+{
+	all_benchmarks().push_back({name, function});
+}
+
+int run_all(std::string_view filter)
+{
+	int count = 0;
+	for (const auto& benchmark: all_benchmarks())
+	{
+		if (filter.empty() == false && benchmark.name.find(filter) == std::string::npos)
+		{
+			continue;
+		}
+
+		std::cout << "--- " << benchmark.name << "\n";
+		benchmark.function();
+		std::cout << "\n";
+		count += 1;
+	}
+
+	if (count == 0)
+	{
+		std::cerr << "No benchmark matched " << filter << "\n";
+		return -1;
+	}
+	return 0;
+}
+
+double measure(std::string_view name, const std::function<void()>& function)
+{
+	using Clock = std::chrono::steady_clock;
+
+	// warmup
+	function();
+
+	std::size_t iterations = 1;
+	while (true)
+	{
+		const auto start = Clock::now();
+		for (std::size_t i = 0; i < iterations; ++i)
+		{
+			function();
+		}
+		const auto seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+		if (seconds >= MIN_MEASURE_SECONDS)
+		{
+			const auto ns = seconds * 1e9 / static_cast<double>(iterations);
+			std::cout << std::setw(40) << std::left << name << " " << std::setw(14) << std::right
+					  << std::fixed << std::setprecision(1) << ns << " ns\n";
+			return ns;
+		}
+
+		iterations *= 2;
+	}
+}
+
+void print_speedup(std::string_view name, double baseline_ns, double measured_ns)
+{
+	std::cout << std::setw(40) << std::left << name << " " << std::setw(14) << std::right
+			  << std::fixed << std::setprecision(2) << (baseline_ns / measured_ns) << " x\n";
+}
+
+void use(float value)
+{
+	sink = sink + value;
+}
+}  //  namespace bench
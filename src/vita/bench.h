@@ -0,0 +1,35 @@
+#pragma once
+
+#include <functional>
+
+/// tiny benchmark runner, mirrors how catch registers test cases
+namespace bench
+{
+using BenchmarkFunction = void (*)();
+
+struct Registrar
+{
+	Registrar(const char* name, BenchmarkFunction function);
+};
+
+int run_all(std::string_view filter);
+
+/// runs the function until the timing is stable, prints and returns the nanoseconds per call
+double measure(std::string_view name, const std::function<void()>& function);
+
+/// prints how much faster (or slower) something was compared to a baseline
+void print_speedup(std::string_view name, double baseline_ns, double measured_ns);
+
+/// feed results here so the optimizer can't remove the work being measured
+void use(float value);
+}  //  namespace bench
+
+#define BENCH_CONCAT_IMPL(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_IMPL(a, b)
+
+#define BENCHMARK(NAME) \
+	static void BENCH_CONCAT(benchmark_function_, __LINE__)(); \
+	static const ::bench::Registrar BENCH_CONCAT(benchmark_registrar_, __LINE__)( \
+		NAME, BENCH_CONCAT(benchmark_function_, __LINE__) \
+	); \
+	static void BENCH_CONCAT(benchmark_function_, __LINE__)()
@@ -0,0 +1,71 @@
+#include "vita/cpu.h"
+
+#if VITA_X86 && defined(_MSC_VER)
+	#include <intrin.h>
+	#include <immintrin.h>
+#endif
+
+namespace cpu
+{
+bool has_avx()
+{
+#if VITA_X86
+	#if defined(_MSC_VER)
+	int info[4] = {0, 0, 0, 0};
+	__cpuid(info, 1);
+	const auto has_avx = (info[2] & (1 << 28)) != 0;
+	const auto has_osxsave = (info[2] & (1 << 27)) != 0;
+	if (has_avx == false || has_osxsave == false)
+	{
+		return false;
+	}
+	// the os needs to save the ymm registers on a context switch
+	return (_xgetbv(0) & 0x6) == 0x6;
+	#else
+	return __builtin_cpu_supports("avx");
+	#endif
+#else
+	return false;
+#endif
+}
+
+const char* to_string(Kernel kernel)
+{
+	switch (kernel)
+	{
+	case Kernel::Scalar: return "scalar";
+	case Kernel::Sse: return "sse";
+	case Kernel::Avx: return "avx";
+	default: return "unknown";
+	}
+}
+
+bool is_supported(Kernel kernel)
+{
+	switch (kernel)
+	{
+	case Kernel::Scalar: return true;
+#if VITA_X86
+	case Kernel::Sse: return true;
+	case Kernel::Avx: return has_avx();
+#endif
+	default: return false;
+	}
+}
+
+Kernel get_best_kernel()
+{
+	static const Kernel best = []()
+	{
+		for (const auto kernel: {Kernel::Avx, Kernel::Sse})
+		{
+			if (is_supported(kernel))
+			{
+				return kernel;
+			}
+		}
+		return Kernel::Scalar;
+	}();
+	return best;
+}
+}  //  namespace cpu
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+/// 1 if the x86 simd kernels are compiled in
+#if defined(__x86_64__) || defined(_M_X64)
+	#define VITA_X86 1
+#else
+	#define VITA_X86 0
+#endif
+
+/// compile a single function for avx, only call it if cpu::has_avx says so
+#if defined(__GNUC__) || defined(__clang__)
+	#define VITA_TARGET_AVX __attribute__((target("avx")))
+#else
+	#define VITA_TARGET_AVX
+#endif
+
+namespace cpu
+{
+/// true if both the cpu and the os supports avx
+bool has_avx();
+
+/// the instruction sets the batch kernels are written for
+enum class Kernel
+{
+	Scalar,
+	Sse,
+	Avx
+};
+
+const char* to_string(Kernel kernel);
+
+/// true if the kernel was compiled in and the cpu can run it
+bool is_supported(Kernel kernel);
+
+/// the widest supported kernel, detected once at startup
+Kernel get_best_kernel();
+
+/// the cache line size of the x86 and arm cores we run on
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+/// starts every allocation on a new cache line, so threads writing to separate whole lines of the
+/// same buffer don't invalidate each others cache
+template<typename T>
+struct CacheLineAllocator
+{
+	using value_type = T;
+
+	CacheLineAllocator() = default;
+
+	template<typename U>
+	CacheLineAllocator(const CacheLineAllocator<U>&)
+	{
+	}
+
+	T* allocate(std::size_t count)
+	{
+		return static_cast<T*>(
+			::operator new(count * sizeof(T), std::align_val_t{CACHE_LINE_SIZE})
+		);
+	}
+
+	void deallocate(T* pointer, std::size_t)
+	{
+		::operator delete(pointer, std::align_val_t{CACHE_LINE_SIZE});
+	}
+};
+
+template<typename T, typename U>
+bool operator==(const CacheLineAllocator<T>&, const CacheLineAllocator<U>&)
+{
+	return true;
+}
+
+template<typename T, typename U>
+bool operator!=(const CacheLineAllocator<T>&, const CacheLineAllocator<U>&)
+{
+	return false;
+}
+
+template<typename T>
+using CacheAlignedVector = std::vector<T, CacheLineAllocator<T>>;
+}  //  namespace cpu
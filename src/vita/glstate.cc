@@ -0,0 +1,165 @@
+#include "vita/glstate.h"
+
+#include "vita/assert.h"
+
+namespace
+{
+/// the cache doesn't know what is bound
+constexpr GLuint UNKNOWN = ~GLuint{0};
+
+/// the texture units the cache tracks, binds to higher units are always made
+constexpr unsigned int CACHED_TEXTURE_UNITS = 16;
+
+struct State
+{
+	GLuint program = UNKNOWN;
+	GLuint vertex_array = UNKNOWN;
+	GLuint default_vertex_array = 0;
+	GLuint array_buffer = UNKNOWN;
+	GLuint element_array_buffer = UNKNOWN;
+	unsigned int active_texture = CACHED_TEXTURE_UNITS;
+	std::array<GLuint, CACHED_TEXTURE_UNITS> texture_2d;
+	std::array<GLuint, CACHED_TEXTURE_UNITS> texture_buffer;
+
+	std::size_t calls = 0;
+	std::size_t skipped = 0;
+
+	State()
+	{
+		texture_2d.fill(UNKNOWN);
+		texture_buffer.fill(UNKNOWN);
+	}
+};
+
+/// gl is only called from the render thread
+State state;
+
+/// true if the bind was skipped, updates the cache otherwise
+bool is_bound(GLuint& cached, GLuint object)
+{
+	if (cached == object)
+	{
+		state.skipped += 1;
+		return true;
+	}
+	cached = object;
+	state.calls += 1;
+	return false;
+}
+
+GLuint& get_buffer(GLenum target)
+{
+	ASSERT(target == GL_ARRAY_BUFFER || target == GL_ELEMENT_ARRAY_BUFFER);
+	return target == GL_ARRAY_BUFFER ? state.array_buffer : state.element_array_buffer;
+}
+
+void set_active_texture(unsigned int unit)
+{
+	if (state.active_texture == unit)
+	{
+		state.skipped += 1;
+		return;
+	}
+	state.active_texture = unit;
+	state.calls += 1;
+	glActiveTexture(GL_TEXTURE0 + unit);
+}
+}  //  namespace
+
+namespace glstate
+{
+void use_program(GLuint program)
+{
+	if (is_bound(state.program, program) == false)
+	{
+		glUseProgram(program);
+	}
+}
+
+void bind_vertex_array(GLuint vertex_array)
+{
+	if (is_bound(state.vertex_array, vertex_array) == false)
+	{
+		glBindVertexArray(vertex_array);
+		state.element_array_buffer = UNKNOWN;
+	}
+}
+
+void set_default_vertex_array(GLuint vertex_array)
+{
+	state.default_vertex_array = vertex_array;
+}
+
+void bind_default_vertex_array()
+{
+	bind_vertex_array(state.default_vertex_array);
+}
+
+void bind_buffer(GLenum target, GLuint buffer)
+{
+	if (is_bound(get_buffer(target), buffer) == false)
+	{
+		glBindBuffer(target, buffer);
+	}
+}
+
+void bind_texture(unsigned int unit, GLenum target, GLuint texture)
+{
+	ASSERT(target == GL_TEXTURE_2D || target == GL_TEXTURE_BUFFER);
+	if (unit >= CACHED_TEXTURE_UNITS)
+	{
+		state.active_texture = unit;
+		state.calls += 2;
+		glActiveTexture(GL_TEXTURE0 + unit);
+		glBindTexture(target, texture);
+		return;
+	}
+
+	auto& cached = target == GL_TEXTURE_2D ? state.texture_2d[unit] : state.texture_buffer[unit];
+	if (cached == texture)
+	{
+		state.skipped += 1;
+		return;
+	}
+	set_active_texture(unit);
+	cached = texture;
+	state.calls += 1;
+	glBindTexture(target, texture);
+}
+
+void invalidate()
+{
+	state.program = UNKNOWN;
+	state.vertex_array = UNKNOWN;
+	state.array_buffer = UNKNOWN;
+	state.element_array_buffer = UNKNOWN;
+	state.active_texture = CACHED_TEXTURE_UNITS;
+	state.texture_2d.fill(UNKNOWN);
+	state.texture_buffer.fill(UNKNOWN);
+}
+
+void count_calls(std::size_t count)
+{
+	state.calls += count;
+}
+
+std::size_t get_total_calls()
+{
+	return state.calls;
+}
+
+std::size_t get_total_skipped()
+{
+	return state.skipped;
+}
+
+void FrameCounter::on_frame()
+{
+	const auto calls = get_total_calls();
+	const auto skipped = get_total_skipped();
+	calls_last_frame = calls - last_calls;
+	skipped_last_frame = skipped - last_skipped;
+	last_calls = calls;
+	last_skipped = skipped;
+}
+}  //  namespace glstate
@@ -0,0 +1,45 @@
+#pragma once
+
+/// a cache of the bound gl objects so binding the same object again never reaches the driver,
+/// every bind of the cached targets must go through here or the cache goes stale
+namespace glstate
+{
+void use_program(GLuint program);
+
+/// the element array binding belongs to the vertex array, so it is forgotten on a switch
+void bind_vertex_array(GLuint vertex_array);
+
+/// the vertex array the app binds when nothing else is, meshes with their own go back to it
+void set_default_vertex_array(GLuint vertex_array);
+void bind_default_vertex_array();
+
+/// only GL_ARRAY_BUFFER and GL_ELEMENT_ARRAY_BUFFER are cached
+void bind_buffer(GLenum target, GLuint buffer);
+
+/// GL_TEXTURE_2D or GL_TEXTURE_BUFFER, the active unit is cached too
+void bind_texture(unsigned int unit, GLenum target, GLuint texture);
+
+/// forget everything, after gl was called directly or an object was deleted since a new object
+/// can get the same name
+void invalidate();
+
+/// for gl calls made outside of the cache so the frame counter sees them
+void count_calls(std::size_t count);
+
+/// the gl calls made through vita since the program started
+std::size_t get_total_calls();
+
+/// the binds the cache skipped since the program started
+std::size_t get_total_skipped();
+
+/// remembers the totals between two frames
+struct FrameCounter
+{
+	std::size_t last_calls = 0;
+	std::size_t last_skipped = 0;
+	std::size_t calls_last_frame = 0;
+	std::size_t skipped_last_frame = 0;
+
+	void on_frame();
+};
+}  //  namespace glstate
@@ -0,0 +1,195 @@
+#include "vita/jobs.h"
+
+#include <algorithm>
+
+namespace jobs
+{
+namespace
+{
+/// the system and queue of the current thread, the thread calling parallel_for doesn't know about
+/// the system so it gets queue 0
+thread_local const JobSystem* current_system = nullptr;
+thread_local std::size_t current_queue = 0;
+
+void run_task(const Task& task)
+{
+	(*task.function)(task.begin, task.end);
+	task.remaining->fetch_sub(1, std::memory_order_acq_rel);
+}
+}  //  namespace
+
+void WorkQueue::push(const Task& task)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	tasks.push_back(task);
+}
+
+std::optional<Task> WorkQueue::pop()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (front == tasks.size())
+	{
+		return std::nullopt;
+	}
+	const auto task = tasks.back();
+	tasks.pop_back();
+	if (front == tasks.size())
+	{
+		tasks.clear();
+		front = 0;
+	}
+	return task;
+}
+
+std::optional<Task> WorkQueue::steal()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (front == tasks.size())
+	{
+		return std::nullopt;
+	}
+	const auto task = tasks[front];
+	front += 1;
+	if (front == tasks.size())
+	{
+		tasks.clear();
+		front = 0;
+	}
+	return task;
+}
+
+JobSystem::JobSystem(std::size_t number_of_workers)
+{
+	for (std::size_t index = 0; index < number_of_workers + 1; ++index)
+	{
+		queues.emplace_back(std::make_unique<WorkQueue>());
+	}
+	for (std::size_t worker = 0; worker < number_of_workers; ++worker)
+	{
+		workers.emplace_back([this, worker]() { run_worker(worker + 1); });
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+		is_stopping = true;
+	}
+	wake_up.notify_all();
+	for (auto& worker: workers)
+	{
+		worker.join();
+	}
+}
+
+std::size_t JobSystem::get_number_of_threads() const
+{
+	return workers.size() + 1;
+}
+
+void JobSystem::parallel_for(std::size_t count, std::size_t grain, const RangeFunction& function)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	grain = std::max<std::size_t>(grain, 1);
+	const auto number_of_tasks = (count + grain - 1) / grain;
+	if (workers.empty() || number_of_tasks == 1)
+	{
+		for (std::size_t begin = 0; begin < count; begin += grain)
+		{
+			function(begin, std::min(begin + grain, count));
+		}
+		return;
+	}
+
+	const auto queue_index = current_system == this ? current_queue : 0;
+
+	// spread the tasks over all queues so the workers don't need to steal to get started
+	std::atomic<std::size_t> remaining = number_of_tasks;
+	for (std::size_t task = 0; task < number_of_tasks; ++task)
+	{
+		const auto begin = task * grain;
+		const auto end = std::min(begin + grain, count);
+		push_task((queue_index + task) % queues.size(), Task{&function, begin, end, &remaining});
+	}
+	{
+		// a worker checking the count under the lock either sees the new tasks or is waiting
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+	}
+	wake_up.notify_all();
+
+	// help out instead of blocking, the tasks left might belong to another parallel_for
+	while (remaining.load(std::memory_order_acquire) > 0)
+	{
+		if (const auto task = find_task(queue_index); task)
+		{
+			run_task(*task);
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::run_worker(std::size_t queue_index)
+{
+	current_system = this;
+	current_queue = queue_index;
+
+	while (true)
+	{
+		if (const auto task = find_task(queue_index); task)
+		{
+			run_task(*task);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleep_mutex);
+		wake_up.wait(lock, [this]() { return is_stopping || number_of_queued_tasks.load() > 0; });
+		if (is_stopping)
+		{
+			return;
+		}
+	}
+}
+
+std::optional<Task> JobSystem::find_task(std::size_t queue_index)
+{
+	if (number_of_queued_tasks.load(std::memory_order_acquire) == 0)
+	{
+		return std::nullopt;
+	}
+
+	auto task = queues[queue_index]->pop();
+
+	// start with the next queue so the thieves don't all go for the same victim
+	for (std::size_t offset = 1; task.has_value() == false && offset < queues.size(); ++offset)
+	{
+		task = queues[(queue_index + offset) % queues.size()]->steal();
+	}
+
+	if (task)
+	{
+		number_of_queued_tasks.fetch_sub(1, std::memory_order_acq_rel);
+	}
+	return task;
+}
+
+void JobSystem::push_task(std::size_t queue_index, const Task& task)
+{
+	// count before pushing so the count never drops below the number of tasks in the queues
+	number_of_queued_tasks.fetch_add(1, std::memory_order_acq_rel);
+	queues[queue_index]->push(task);
+}
+
+std::size_t get_default_number_of_workers()
+{
+	const auto hardware = static_cast<std::size_t>(std::thread::hardware_concurrency());
+	return hardware > 1 ? hardware - 1 : 0;
+}
+}  //  namespace jobs
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <optional>
+#include <type_traits>
+
+namespace jobs
+{
+/// called with a [begin, end) range of indices. Doesn't own or copy the callable so the callable
+/// must outlive it, which a lambda passed directly to parallel_for always does. Unlike a
+/// std::function this never allocates, no matter how much the lambda captures
+struct RangeFunction
+{
+	template<
+		typename Function,
+		typename = std::enable_if_t<! std::is_same_v<std::decay_t<Function>, RangeFunction>>>
+	RangeFunction(Function&& function)
+		: context(const_cast<void*>(static_cast<const void*>(&function)))
+		, trampoline(&call<std::remove_reference_t<Function>>)
+	{
+	}
+
+	void operator()(std::size_t begin, std::size_t end) const
+	{
+		trampoline(context, begin, end);
+	}
+
+	template<typename Function>
+	static void call(void* context, std::size_t begin, std::size_t end)
+	{
+		(*static_cast<Function*>(context))(begin, end);
+	}
+
+	void* context;
+	void (*trampoline)(void* context, std::size_t begin, std::size_t end);
+};
+
+/// a part of a parallel_for call
+struct Task
+{
+	const RangeFunction* function = nullptr;
+	std::size_t begin = 0;
+	std::size_t end = 0;
+
+	/// the number of tasks left in the parallel_for this task belongs to
+	std::atomic<std::size_t>* remaining = nullptr;
+};
+
+/// the tasks of a single thread, the owner takes the newest task from the back while other
+/// threads steal the oldest (and usually largest remaining chunk of work) from the front. The tasks
+/// before front are already stolen, the vector is only cleared when empty so it keeps its capacity
+/// and doesn't allocate once it has grown, unlike a deque that keeps allocating new blocks
+struct WorkQueue
+{
+	std::mutex mutex;
+	std::vector<Task> tasks;
+	std::size_t front = 0;
+
+	void push(const Task& task);
+	std::optional<Task> pop();
+	std::optional<Task> steal();
+};
+
+/// a fixed set of worker threads, the thread calling parallel_for helps out until its work is done
+struct JobSystem
+{
+	/// 0 workers runs everything on the calling thread
+	explicit JobSystem(std::size_t number_of_workers);
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	void operator=(const JobSystem&) = delete;
+
+	/// the workers and the calling thread
+	std::size_t get_number_of_threads() const;
+
+	/// call the function for all indices below count, in chunks of grain indices, and wait until
+	/// all are done. Can be called from inside a job but only from one thread outside the workers
+	void parallel_for(std::size_t count, std::size_t grain, const RangeFunction& function);
+
+	/// queue 0 belongs to the thread calling parallel_for, the rest to the workers
+	std::vector<std::unique_ptr<WorkQueue>> queues;
+	std::vector<std::thread> workers;
+
+	std::mutex sleep_mutex;
+	std::condition_variable wake_up;
+	std::atomic<std::size_t> number_of_queued_tasks = 0;
+	bool is_stopping = false;
+
+	void run_worker(std::size_t queue_index);
+	std::optional<Task> find_task(std::size_t queue_index);
+	void push_task(std::size_t queue_index, const Task& task);
+};
+
+/// one worker per extra hardware thread
+std::size_t get_default_number_of_workers();
+}  //  namespace jobs
@@ -0,0 +1,67 @@
+#include "catch.hpp"
+
+#include "vita/jobs.h"
+
+TEST_CASE("jobs parallel for")
+{
+	constexpr std::size_t count = 1000;
+
+	for (std::size_t workers = 0; workers < 4; workers += 1)
+	{
+		auto job_system = jobs::JobSystem{workers};
+		CHECK(job_system.get_number_of_threads() == workers + 1);
+
+		for (const std::size_t grain: {1, 7, 64, 5000})
+		{
+			std::vector<std::atomic<int>> calls(count);
+			std::atomic<bool> is_range_too_large = false;
+			job_system.parallel_for(
+				count,
+				grain,
+				[&](std::size_t begin, std::size_t end)
+				{
+					// catch isn't thread safe so check on this thread later
+					if (end - begin > grain)
+					{
+						is_range_too_large = true;
+					}
+					for (auto index = begin; index < end; ++index)
+					{
+						calls[index] += 1;
+					}
+				}
+			);
+
+			CHECK_FALSE(is_range_too_large);
+			for (const auto& call: calls)
+			{
+				REQUIRE(call == 1);
+			}
+		}
+
+		// the inner loops run while the outer loop waits for them
+		std::vector<std::atomic<int>> nested(count);
+		job_system.parallel_for(
+			10,
+			1,
+			[&](std::size_t outer, std::size_t)
+			{
+				job_system.parallel_for(
+					100,
+					10,
+					[&](std::size_t begin, std::size_t end)
+					{
+						for (auto index = begin; index < end; ++index)
+						{
+							nested[outer * 100 + index] += 1;
+						}
+					}
+				);
+			}
+		);
+		for (const auto& call: nested)
+		{
+			REQUIRE(call == 1);
+		}
+	}
+}
@@ -0,0 +1,6 @@
+#include "vita/bench.h"
+
+int main(int argc, char* argv[])
+{
+	return bench::run_all(argc > 1 ? argv[1] : "");
+}
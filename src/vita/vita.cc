@@ -5,6 +5,8 @@
 #include "imgui_impl_opengl3.h"
 
 #include "vita/opengl_utils.h"
+#include "vita/allocations.h"
+#include "vita/glstate.h"
 
 constexpr int start_width = 800;
 constexpr int starth_height = 600;
@@ -15,6 +17,7 @@ int app_main(MakeAppFunction make_app, SDL_Window* sdl_window)
 	GLuint ugly_array_object_hack = 0;
 	glGenVertexArrays(1, &ugly_array_object_hack);
 	glBindVertexArray(ugly_array_object_hack);
+	glstate::set_default_vertex_array(ugly_array_object_hack);
 
 	auto app = make_app();
 
@@ -30,9 +33,16 @@ int app_main(MakeAppFunction make_app, SDL_Window* sdl_window)
 
 	bool mouse = false;
 
+	auto allocation_counter = allocations::FrameCounter{};
+	auto gl_call_counter = glstate::FrameCounter{};
+
 	auto last = SDL_GetPerformanceCounter();
 	while (running)
 	{
+		allocation_counter.on_frame();
+		gl_call_counter.on_frame();
+		glstate::invalidate();
+
 		const auto now = SDL_GetPerformanceCounter();
 		const auto diff = static_cast<float>(now - last);
 		const auto freq = static_cast<float>(SDL_GetPerformanceFrequency());
@@ -101,12 +111,26 @@ int app_main(MakeAppFunction make_app, SDL_Window* sdl_window)
 		ImGui::NewFrame();
 
 		app->on_gui();
+		if (allocations::is_counting())
+		{
+			ImGui::Text(
+				"Heap allocations last frame: %d",
+				static_cast<int>(allocation_counter.allocations_last_frame)
+			);
+		}
+		ImGui::Text(
+			"GL calls last frame: %d (%d binds skipped)",
+			static_cast<int>(gl_call_counter.calls_last_frame),
+			static_cast<int>(gl_call_counter.skipped_last_frame)
+		);
 
 		ImGui::Render();
 
 
 		// render
-		glBindVertexArray(ugly_array_object_hack);
+		// imgui and the frame setup call gl directly
+		glstate::invalidate();
+		glstate::bind_default_vertex_array();
 		app->on_render(aspect);
 
 		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());